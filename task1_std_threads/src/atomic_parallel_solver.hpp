@@ -0,0 +1,280 @@
+#pragma once
+
+#include "base_solver.hpp"
+#include "chunking.hpp"
+#include "predicates.hpp"
+#include "simd_search.hpp"
+#include "stream_compaction.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <future>
+#include <limits>
+#include <thread>
+#include <optional>
+#include <vector>
+
+
+/**
+ * Параллельная реализация задачи с использованием std::thread без мьютекса
+ * Минимальный найденный индекс публикуется через std::atomic<size_t>
+ * Результаты из потоков, как и в ParallelSolver, возвращаются через promise/future
+ *
+ * Суть:
+ *   - массив делится на части, каждая часть обрабатывается отдельным потоком
+ *   - каждый поток просматривает свою часть блоками по block_size элементов
+ *   - перед каждым блоком поток читает global_min_index_ (relaxed-загрузка, без блокировок)
+ *     и завершается досрочно, если другой поток уже нашёл элемент левее начала блока
+ *   - найденный индекс публикуется циклом CAS-min: значение меняется, только если новый индекс меньше
+ *   - итоговый индекс - минимум из локальных результатов, полученных через future
+ *
+ * Отличие от ParallelSolver: нет захвата мьютекса на каждый элемент,
+ * поэтому потоки не сериализуются и решение масштабируется по числу ядер
+ */
+template<typename T>
+class AtomicParallelSolver : public BaseSolver<T> {
+public:
+    /**
+     * Конструктор
+     * @param num_threads количество потоков (опционально, если не указано - используется значение hardware_concurrency)
+     * @param block_size сколько элементов просматривается между проверками глобального индекса
+     */
+    explicit AtomicParallelSolver(std::optional<int> num_threads = std::nullopt, std::size_t block_size = 4096)
+        : block_size_(std::max<std::size_t>(block_size, 1)) {
+        if (num_threads.has_value()) {
+            num_threads_ = num_threads.value();
+        } else {
+            auto hc = std::thread::hardware_concurrency();
+            if (hc == 0) {
+                num_threads_ = 2; // fallback на случай, если hardware_concurrency не работает
+            } else {
+                num_threads_ = hc;
+            }
+        }
+    }
+
+private:
+    // Значение global_min_index_, означающее "ничего не найдено"
+    static constexpr std::size_t kNotFound = std::numeric_limits<std::size_t>::max();
+
+    struct FutureResult {
+        // Локальный индекс элемента, большего порога
+        // или std::nullopt, если элемент не найден
+        std::optional<std::size_t> index = std::nullopt;
+        // Флаг, сигнализирующий о досрочном завершении потока
+        bool exited_early = false;
+    };
+
+public:
+    std::optional<T> solve(std::span<const T> arr, T threshold) override {
+        return find_first(arr, Greater<T>{threshold});
+    }
+
+    /**
+     * Первый элемент, для которого pred истинно (предикаты - см. predicates.hpp)
+     * Предикат - параметр шаблона, поэтому каждый поток просматривает блоки ядром find_first_if,
+     * собранным под конкретный предикат, без косвенных вызовов на элемент
+     */
+    template<typename Pred>
+    std::optional<T> find_first(std::span<const T> arr, const Pred& pred) {
+        if (arr.empty()) {
+            return std::nullopt;
+        }
+
+        int actual_threads = std::min(num_threads_, static_cast<int>(arr.size()));
+
+        // Сбрасываем результат предыдущего вызова
+        global_min_index_.store(kNotFound, std::memory_order_relaxed);
+
+        std::vector<std::thread> threads;
+        std::vector<std::future<FutureResult>> futures;
+        threads.reserve(actual_threads);
+        futures.reserve(actual_threads);
+
+        // Создаём и запускаем потоки, по одному на часть массива
+        for (const ChunkRange& chunk : split_into_chunks(arr.size(), actual_threads)) {
+            std::promise<FutureResult> promise;
+            futures.push_back(promise.get_future());
+
+            threads.emplace_back(
+                &AtomicParallelSolver::worker_thread<Pred>,
+                this,
+                arr,
+                pred,
+                chunk.begin,
+                chunk.end,
+                std::move(promise)
+            );
+        }
+
+        // Редукция по минимуму из локальных индексов, полученных через future
+        std::size_t min_index = kNotFound;
+        for (auto& future : futures) {
+            auto result = future.get();
+            if (result.index.has_value()) {
+                min_index = std::min(min_index, result.index.value());
+            }
+        }
+
+        for (auto& thread : threads) {
+            thread.join();
+        }
+
+        // Элемент, больший порога, не найден
+        if (min_index == kNotFound) {
+            return std::nullopt;
+        }
+
+        return arr[min_index];
+    }
+
+    /**
+     * Несколько порогов за один параллельный проход
+     * Каждый поток гасит пороги в своей части (scan_many), результаты возвращаются через future
+     * и сливаются слева направо (merge_many)
+     */
+    std::vector<std::optional<T>> solve_many(std::span<const T> arr, std::span<const T> thresholds) override {
+        SortedThresholds<T> sorted = sort_thresholds(thresholds);
+        if (arr.empty() || sorted.values.empty()) {
+            return std::vector<std::optional<T>>(thresholds.size(), std::nullopt);
+        }
+
+        int actual_threads = std::min(num_threads_, static_cast<int>(arr.size()));
+
+        std::vector<std::thread> threads;
+        std::vector<std::future<std::vector<std::size_t>>> futures;
+        threads.reserve(actual_threads);
+        futures.reserve(actual_threads);
+
+        for (const ChunkRange& chunk : split_into_chunks(arr.size(), actual_threads)) {
+            std::promise<std::vector<std::size_t>> promise;
+            futures.push_back(promise.get_future());
+            threads.emplace_back(
+                [&arr, &sorted, chunk](std::promise<std::vector<std::size_t>> result_promise) {
+                    result_promise.set_value(scan_many(arr.data(), chunk.begin, chunk.end, sorted.values));
+                },
+                std::move(promise)
+            );
+        }
+
+        std::vector<std::vector<std::size_t>> chunk_results;
+        chunk_results.reserve(actual_threads);
+        for (auto& future : futures) {
+            chunk_results.push_back(future.get());
+        }
+
+        for (auto& thread : threads) {
+            thread.join();
+        }
+
+        return merge_many(arr.data(), sorted, chunk_results);
+    }
+
+    /**
+     * Индексы первых out.size() элементов больше порога, по возрастанию, в заранее выделенный out
+     * Параллельно: подсчёт по частям, префиксные суммы, запись каждой частью своего отрезка (stream_compaction.hpp)
+     * @return сколько индексов записано
+     */
+    std::size_t select_indices(std::span<const T> arr, T threshold, std::span<std::size_t> out) {
+        return parallel_select_indices(arr, Greater<T>{threshold}, out.size(), num_threads_,
+                                       [&out](std::size_t) { return out.data(); });
+    }
+
+    /**
+     * Индексы всех элементов больше порога, по возрастанию
+     * Выходной массив выделяется один раз, когда после подсчёта известно число совпадений
+     */
+    std::vector<std::size_t> select_indices(std::span<const T> arr, T threshold) {
+        std::vector<std::size_t> indices;
+        parallel_select_indices(arr, Greater<T>{threshold}, arr.size(), num_threads_,
+                                [&indices](std::size_t total) {
+                                    indices.resize(total);
+                                    return indices.data();
+                                });
+        return indices;
+    }
+
+    /**
+     * Число элементов больше порога: только параллельный подсчёт по частям, без выделения и записи индексов
+     */
+    std::size_t count_greater(std::span<const T> arr, T threshold) {
+        return parallel_select_indices(arr, Greater<T>{threshold}, arr.size(), num_threads_,
+                                       [](std::size_t) -> std::size_t* { return nullptr; });
+    }
+
+    /**
+     * Первые k элементов больше порога в порядке следования в массиве (меньше k, если столько не нашлось)
+     */
+    std::vector<T> solve_first_k(std::span<const T> arr, T threshold, std::size_t k) {
+        std::vector<std::size_t> indices(std::min(k, arr.size()));
+        indices.resize(select_indices(arr, threshold, std::span<std::size_t>(indices)));
+
+        std::vector<T> values;
+        values.reserve(indices.size());
+        for (std::size_t index : indices) {
+            values.push_back(arr[index]);
+        }
+        return values;
+    }
+
+    std::string get_name() const override {
+        return "Параллельная версия (std::thread + atomic, " + std::to_string(num_threads_) + " потоков)";
+    }
+
+private:
+    /**
+     * Функция, выполняемая каждым потоком
+     *
+     * @param arr ссылка на массив данных
+     * @param pred условие поиска
+     * @param start_idx начальный индекс для обработки этим потоком
+     * @param end_idx конечный индекс (не включительно)
+     * @param result_promise promise для возврата локального минимального индекса
+     */
+    template<typename Pred>
+    void worker_thread(
+        std::span<const T> arr,
+        Pred pred,
+        std::size_t start_idx,
+        std::size_t end_idx,
+        std::promise<FutureResult>&& result_promise
+    ) {
+        for (std::size_t block_start = start_idx; block_start < end_idx; block_start += block_size_) {
+            // Раз в блок проверяем, не нашёл ли другой поток элемент левее
+            // relaxed достаточно: индекс используется только как подсказка для досрочного выхода,
+            // итоговый ответ собирается через future
+            if (global_min_index_.load(std::memory_order_relaxed) < block_start) {
+                result_promise.set_value(FutureResult{std::nullopt, true});
+                return;
+            }
+
+            std::size_t block_end = std::min(block_start + block_size_, end_idx);
+            std::size_t block_len = block_end - block_start;
+            std::size_t offset = find_first_if(arr.data() + block_start, block_len, pred);
+            if (offset != block_len) {
+                std::size_t i = block_start + offset;
+                publish_min_index(i);
+                result_promise.set_value(FutureResult{i, false});
+                return;
+            }
+        }
+
+        result_promise.set_value(FutureResult{std::nullopt, false});
+    }
+
+    /**
+     * Атомарно заменить global_min_index_ на index, если index меньше текущего значения (CAS-min)
+     */
+    void publish_min_index(std::size_t index) {
+        std::size_t current = global_min_index_.load(std::memory_order_relaxed);
+        while (index < current &&
+               !global_min_index_.compare_exchange_weak(current, index, std::memory_order_relaxed)) {
+            // current обновлён compare_exchange_weak - пробуем снова
+        }
+    }
+
+private:
+    int num_threads_;
+    std::size_t block_size_;
+    std::atomic<std::size_t> global_min_index_ = kNotFound;
+};
@@ -0,0 +1,122 @@
+#pragma once
+
+#include "simd_search.hpp"
+
+#include <cassert>
+
+#include <algorithm>
+#include <cstddef>
+#include <span>
+#include <vector>
+
+
+/**
+ * Сводка "максимум на блок" для массива: по одному значению на каждые block_size элементов
+ * (при блоке 64 - примерно 1/64 объёма данных)
+ *
+ * Используется решателями для пропуска целых блоков: если максимум блока <= порога,
+ * в блоке заведомо нет подходящего элемента, и читать его не нужно.
+ * Сама сводка просматривается тем же векторным ядром find_first_greater,
+ * так что при высоком пороге читается только она, а не весь массив
+ *
+ * Сводка не владеет массивом и не следит за ним сама: изменения элементов нужно делать
+ * через update (либо заново вызывать build). Проверить, что сводка соответствует содержимому массива, она не может:
+ * это контракт вызывающего - подключать сводку только к тому массиву, по которому она построена,
+ * и поддерживать её при каждом изменении. Устаревшая сводка молча пропустит блоки, в которых уже есть совпадения
+ */
+template<typename T>
+class BlockMaxSummary {
+public:
+    /**
+     * Конструктор
+     * @param block_size количество элементов массива на одно значение сводки
+     */
+    explicit BlockMaxSummary(std::size_t block_size = 64)
+        : block_size_(std::max<std::size_t>(block_size, 1)) {}
+
+    /**
+     * Построить сводку по массиву
+     */
+    void build(std::span<const T> arr) {
+        size_ = arr.size();
+        block_max_.resize((size_ + block_size_ - 1) / block_size_);
+        for (std::size_t b = 0; b < block_max_.size(); b++) {
+            block_max_[b] = compute_block_max(arr, b);
+        }
+    }
+
+    /**
+     * Записать arr[index] = value и поддержать сводку
+     * Обычно O(1); пересчёт блока за O(block_size) нужен, только если уменьшился его максимальный элемент
+     */
+    void update(std::span<T> arr, std::size_t index, T value) {
+        assert(arr.size() == size_);
+        T old_value = arr[index];
+        arr[index] = value;
+
+        std::size_t b = index / block_size_;
+        if (value >= block_max_[b]) {
+            block_max_[b] = value;
+        } else if (old_value == block_max_[b]) {
+            block_max_[b] = compute_block_max(arr, b);
+        }
+    }
+
+    /**
+     * Первый индекс из [begin, end) с data[i] > threshold, или end, если такого нет
+     * Блоки с максимумом <= threshold пропускаются, не читая данных
+     */
+    std::size_t find_first_greater(const T* data, std::size_t begin, std::size_t end, T threshold) const {
+        std::size_t pos = begin;
+        while (pos < end) {
+            std::size_t b = pos / block_size_;
+            std::size_t last_block = (end - 1) / block_size_;
+            // Первый блок, начиная с текущего, в котором может быть подходящий элемент
+            std::size_t offset = ::find_first_greater(block_max_.data() + b, last_block + 1 - b, threshold);
+            if (offset == last_block + 1 - b) {
+                return end;
+            }
+            b += offset;
+
+            std::size_t block_begin = std::max(pos, b * block_size_);
+            std::size_t block_end = std::min(end, (b + 1) * block_size_);
+            std::size_t found = ::find_first_greater(data + block_begin, block_end - block_begin, threshold);
+            if (found != block_end - block_begin) {
+                return block_begin + found;
+            }
+            // Подходящий элемент блока оказался левее begin - идём дальше
+            pos = block_end;
+        }
+        return end;
+    }
+
+    /**
+     * Максимум блока, в который попадает index
+     */
+    T block_max_at(std::size_t index) const {
+        return block_max_[index / block_size_];
+    }
+
+    /**
+     * Количество элементов массива, для которого построена сводка
+     */
+    std::size_t size() const {
+        return size_;
+    }
+
+    std::size_t block_size() const {
+        return block_size_;
+    }
+
+private:
+    T compute_block_max(std::span<const T> arr, std::size_t b) const {
+        std::size_t block_begin = b * block_size_;
+        std::size_t block_end = std::min(block_begin + block_size_, arr.size());
+        return *std::max_element(arr.begin() + block_begin, arr.begin() + block_end);
+    }
+
+private:
+    std::size_t block_size_;
+    std::size_t size_ = 0;
+    std::vector<T> block_max_;
+};
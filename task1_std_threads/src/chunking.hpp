@@ -0,0 +1,43 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+/**
+ * Разбиение массива на части для потоков
+ *
+ * Массив из n элементов делится на parts непрерывных частей почти равного размера:
+ * первые n % parts частей на один элемент длиннее. Части идут слева направо,
+ * поэтому часть i целиком левее части i + 1 - на этом держатся досрочный выход по минимальному индексу
+ * и слияние результатов частей слева направо
+ */
+struct ChunkRange {
+    // Начало части (включительно)
+    std::size_t begin = 0;
+    // Конец части (не включительно)
+    std::size_t end = 0;
+
+    std::size_t size() const {
+        return end - begin;
+    }
+};
+
+/**
+ * Разбить [0, n) на parts частей (parts > 0)
+ */
+inline std::vector<ChunkRange> split_into_chunks(std::size_t n, std::size_t parts) {
+    std::vector<ChunkRange> chunks;
+    chunks.reserve(parts);
+
+    // Размер части для каждого потока
+    std::size_t chunk_size = n / parts;
+    std::size_t remainder = n % parts;
+
+    std::size_t current_start = 0;
+    for (std::size_t i = 0; i < parts; i++) {
+        std::size_t current_end = current_start + chunk_size + (i < remainder ? 1 : 0);
+        chunks.push_back(ChunkRange{current_start, current_end});
+        current_start = current_end;
+    }
+    return chunks;
+}
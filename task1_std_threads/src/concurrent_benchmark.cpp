@@ -0,0 +1,335 @@
+#include "versioned_array.hpp"
+#include "workload.hpp"
+
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <optional>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * Бенчмарк поиска во время записи: задержка запросов к VersionedArray под нагрузкой писателей
+ *
+ * Читатели в цикле берут снимок и ищут в нём первый элемент больше порога (SnapshotSolver на пуле потоков),
+ * писатели в цикле публикуют новые версии (update_batch, при желании - append).
+ * В каждой версии писатель переносит единственное совпадение: старое место затирается значением не больше порога,
+ * а на новом случайном месте появляется значение больше порога, которое кодирует свой индекс (match_value).
+ * Оба изменения входят в один update_batch, поэтому в любом согласованном снимке ровно одно совпадение,
+ * и ответ меняется от версии к версии.
+ * Сначала меряется задержка без писателей, затем с ними; печатаются медиана, p99 и максимум задержки запроса,
+ * число запросов и опубликованных версий в секунду. С --verify каждый ответ проверяется по тому же снимку:
+ * совпадает с последовательным проходом, значение по ответу кодирует свой индекс, и второго совпадения нет.
+ * Снимок, собранный из блоков разных версий, дал бы ноль или два совпадения
+ */
+
+namespace {
+
+constexpr long long kThreshold = 5000000;
+
+/**
+ * Значение совпадения на позиции index: больше порога и по нему восстанавливается индекс
+ */
+long long match_value(std::size_t index) {
+    return kThreshold + 1 + static_cast<long long>(index);
+}
+
+struct ConcurrentConfig {
+    std::size_t size = 10000000;
+    std::size_t block_size = 4096;
+    double match_position = 0.5;
+    int readers = 1;
+    int solver_threads = 2;
+    std::vector<int> writers = {0, 1, 2};
+    std::size_t write_batch = 16;
+    std::size_t append = 0;
+    int duration_ms = 2000;
+    bool verify = false;
+    std::uint64_t seed = 42;
+};
+
+struct PhaseResult {
+    int writers = 0;
+    std::size_t queries = 0;
+    double median_us = 0;
+    double p99_us = 0;
+    double max_us = 0;
+    double queries_per_second = 0;
+    double versions_per_second = 0;
+    std::size_t final_size = 0;
+    std::size_t mismatches = 0;
+};
+
+void print_usage(const char* prog_name) {
+    std::cout << "Использование: " << prog_name << " [опции]" << std::endl;
+    std::string usage = R"(
+Бенчмарк поиска по версионированному массиву во время записи
+Опции:
+  --size N                      - начальный размер массива (по умолчанию 10000000)
+  --block N                     - размер блока копирования при записи (по умолчанию 4096)
+  --match-pos доля              - позиция первого элемента больше порога как доля размера (по умолчанию 0.5)
+  --readers N                   - число потоков-читателей (по умолчанию 1)
+  --solver-threads N            - потоков пула у каждого читателя (по умолчанию 2)
+  --writers W1,W2,...           - число потоков-писателей в каждой фазе (по умолчанию 0,1,2)
+  --write-batch N               - изменений в одной версии (по умолчанию 16)
+  --append N                    - сколько значений писатель дописывает в конец после каждой версии (по умолчанию 0)
+  --duration-ms N               - длительность фазы (по умолчанию 2000)
+  --verify                      - проверять каждый ответ по тому же снимку: последовательный проход
+                                  и ровно одно совпадение, кодирующее свой индекс
+  --seed N                      - зерно генератора (по умолчанию 42)
+)";
+    std::cout << usage << std::endl;
+}
+
+/**
+ * Перцентиль по методу ближайшего ранга; values должны быть отсортированы
+ */
+double percentile(const std::vector<double>& values, double p) {
+    if (values.empty()) {
+        return 0;
+    }
+    std::size_t rank = static_cast<std::size_t>(std::ceil(p * values.size()));
+    return values[std::min(values.size() - 1, rank == 0 ? 0 : rank - 1)];
+}
+
+/**
+ * Ответ index согласован со снимком: совпадает с последовательным проходом, значение по нему - match_value(index),
+ * и больше ни одного значения выше порога в снимке нет (блоки с максимумом не больше порога не читаются)
+ */
+bool consistent_answer(const ArraySnapshot<long long>& snapshot, std::size_t index) {
+    if (index != snapshot.find_first_greater(kThreshold) || index >= snapshot.size() ||
+        snapshot[index] != match_value(index)) {
+        return false;
+    }
+    std::size_t matches = 0;
+    for (std::size_t b = 0; b < snapshot.block_count(); b++) {
+        if (snapshot.block_max(b) <= kThreshold) {
+            continue;
+        }
+        for (long long value : snapshot.block(b)) {
+            matches += value > kThreshold ? 1 : 0;
+        }
+    }
+    return matches == 1;
+}
+
+/**
+ * Одна фаза: readers читателей и num_writers писателей работают duration_ms миллисекунд над свежей копией массива
+ */
+PhaseResult run_phase(const ConcurrentConfig& config, std::span<const long long> initial, std::size_t planted, int num_writers) {
+    using clock = std::chrono::steady_clock;
+    using namespace workload_detail;
+
+    VersionedArray<long long> array(initial, config.block_size);
+    std::uint64_t start_version = array.version();
+    std::atomic<bool> stop{false};
+
+    // Писатели переносят совпадение: в одной версии старое место затирается, а новое получает match_value.
+    // Где сейчас совпадение, знает только писатель, поэтому сборка пакета и публикация идут под match_mutex
+    // (публикации писателей и так упорядочены мьютексом VersionedArray); читатели этот мьютекс не берут
+    std::mutex match_mutex;
+    std::size_t current_match = planted;
+    std::vector<std::thread> writers;
+    for (int w = 0; w < num_writers; w++) {
+        writers.emplace_back([&, w] {
+            std::mt19937_64 rng(config.seed * 1000003 + static_cast<std::uint64_t>(w) + 1);
+            std::vector<std::pair<std::size_t, long long>> updates;
+            std::vector<long long> tail(config.append);
+            while (!stop.load(std::memory_order_relaxed)) {
+                std::lock_guard<std::mutex> lock(match_mutex);
+                std::size_t size = array.snapshot()->size();
+                std::size_t next_match = rng() % size;
+
+                // Пакет без повторов старого и нового места совпадения: порядок изменений одного индекса не задан
+                updates.clear();
+                if (next_match != current_match) {
+                    updates.emplace_back(current_match, below<long long>(rng(), kThreshold));
+                }
+                for (std::size_t k = 0; k < config.write_batch; k++) {
+                    std::size_t index = rng() % size;
+                    if (index != current_match && index != next_match) {
+                        updates.emplace_back(index, below<long long>(rng(), kThreshold));
+                    }
+                }
+                updates.emplace_back(next_match, match_value(next_match));
+                array.update_batch(updates);
+                current_match = next_match;
+
+                if (!tail.empty()) {
+                    for (auto& value : tail) {
+                        value = below<long long>(rng(), kThreshold);
+                    }
+                    array.append(tail);
+                }
+            }
+        });
+    }
+
+    std::vector<std::vector<double>> latencies(config.readers);
+    std::vector<std::size_t> mismatches(config.readers, 0);
+    std::vector<std::thread> readers;
+    auto phase_start = clock::now();
+    auto deadline = phase_start + std::chrono::milliseconds(config.duration_ms);
+    for (int r = 0; r < config.readers; r++) {
+        readers.emplace_back([&, r] {
+            SnapshotSolver<long long> solver(config.solver_threads);
+            while (clock::now() < deadline) {
+                auto start = clock::now();
+                auto snapshot = array.snapshot();
+                std::size_t index = solver.first_index(*snapshot, kThreshold);
+                latencies[r].push_back(std::chrono::duration<double, std::micro>(clock::now() - start).count());
+
+                if (config.verify && !consistent_answer(*snapshot, index)) {
+                    mismatches[r]++;
+                }
+            }
+        });
+    }
+    for (auto& reader : readers) {
+        reader.join();
+    }
+    double seconds = std::chrono::duration<double>(clock::now() - phase_start).count();
+    stop.store(true, std::memory_order_relaxed);
+    for (auto& writer : writers) {
+        writer.join();
+    }
+
+    std::vector<double> all;
+    for (const auto& reader_latencies : latencies) {
+        all.insert(all.end(), reader_latencies.begin(), reader_latencies.end());
+    }
+    std::sort(all.begin(), all.end());
+
+    PhaseResult result;
+    result.writers = num_writers;
+    result.queries = all.size();
+    result.median_us = percentile(all, 0.5);
+    result.p99_us = percentile(all, 0.99);
+    result.max_us = all.empty() ? 0 : all.back();
+    result.queries_per_second = all.size() / seconds;
+    result.versions_per_second = (array.version() - start_version) / seconds;
+    result.final_size = array.snapshot()->size();
+    for (std::size_t m : mismatches) {
+        result.mismatches += m;
+    }
+    return result;
+}
+
+std::vector<int> parse_list(const std::string& list) {
+    std::vector<int> items;
+    std::size_t pos = 0;
+    while (pos <= list.size()) {
+        std::size_t comma = list.find(',', pos);
+        std::string item = list.substr(pos, comma == std::string::npos ? std::string::npos : comma - pos);
+        if (!item.empty()) {
+            items.push_back(std::max(std::atoi(item.c_str()), 0));
+        }
+        if (comma == std::string::npos) {
+            break;
+        }
+        pos = comma + 1;
+    }
+    return items;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    ConcurrentConfig config;
+
+    // Обработка аргументов командной строки
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "-h" || arg == "--help") {
+            print_usage(argv[0]);
+            return 0;
+        }
+        if (arg == "--verify") {
+            config.verify = true;
+            continue;
+        }
+        if (i + 1 >= argc) {
+            std::cerr << "Ошибка: неизвестный аргумент или нет значения: " << arg << std::endl;
+            print_usage(argv[0]);
+            return 1;
+        }
+        std::string value = argv[++i];
+        if (arg == "--size") {
+            config.size = std::max<std::size_t>(std::strtoull(value.c_str(), nullptr, 10), 1);
+        } else if (arg == "--block") {
+            config.block_size = std::max<std::size_t>(std::strtoull(value.c_str(), nullptr, 10), 1);
+        } else if (arg == "--match-pos") {
+            config.match_position = std::atof(value.c_str());
+        } else if (arg == "--readers") {
+            config.readers = std::max(std::atoi(value.c_str()), 1);
+        } else if (arg == "--solver-threads") {
+            config.solver_threads = std::max(std::atoi(value.c_str()), 1);
+        } else if (arg == "--writers") {
+            config.writers = parse_list(value);
+        } else if (arg == "--write-batch") {
+            config.write_batch = std::max<std::size_t>(std::strtoull(value.c_str(), nullptr, 10), 1);
+        } else if (arg == "--append") {
+            config.append = std::strtoull(value.c_str(), nullptr, 10);
+        } else if (arg == "--duration-ms") {
+            config.duration_ms = std::max(std::atoi(value.c_str()), 1);
+        } else if (arg == "--seed") {
+            config.seed = std::strtoull(value.c_str(), nullptr, 10);
+        } else {
+            std::cerr << "Ошибка: неизвестный аргумент " << arg << std::endl;
+            print_usage(argv[0]);
+            return 1;
+        }
+    }
+
+    WorkloadSpec<long long> workload;
+    workload.pattern = WorkloadPattern::Planted;
+    workload.match_position = config.match_position;
+    workload.threshold = kThreshold;
+    workload.seed = config.seed;
+    auto initial = make_workload_array<long long>(config.size, workload);
+    std::size_t planted = std::min(planted_index(workload, config.size), config.size - 1);
+    // Единственное совпадение в начальном массиве - тоже кодирует свой индекс
+    initial[planted] = match_value(planted);
+
+    std::cout << "Размер массива: " << config.size << ", блок: " << config.block_size
+              << ", первое совпадение в начальной версии: " << planted << std::endl;
+    std::cout << "Читателей: " << config.readers << " (по " << config.solver_threads << " потоков пула)"
+              << ", изменений в версии: " << config.write_batch << ", дописывается за версию: " << config.append << std::endl;
+    std::cout << "========================================" << std::endl;
+    std::cout << std::fixed << std::setprecision(1) << std::left
+              << std::setw(9) << "writers" << std::setw(10) << "queries" << std::setw(12) << "median_us"
+              << std::setw(12) << "p99_us" << std::setw(12) << "max_us" << std::setw(12) << "queries/s"
+              << std::setw(13) << "versions/s" << std::setw(12) << "final_size";
+    if (config.verify) {
+        std::cout << "mismatches";
+    }
+    std::cout << std::endl;
+
+    bool consistent = true;
+    for (int writers : config.writers) {
+        PhaseResult r = run_phase(config, std::span<const long long>(initial.get(), config.size), planted, writers);
+        std::cout << std::setw(9) << r.writers << std::setw(10) << r.queries << std::setw(12) << r.median_us
+                  << std::setw(12) << r.p99_us << std::setw(12) << r.max_us << std::setw(12) << r.queries_per_second
+                  << std::setw(13) << r.versions_per_second << std::setw(12) << r.final_size;
+        if (config.verify) {
+            std::cout << r.mismatches;
+            consistent = consistent && r.mismatches == 0;
+        }
+        std::cout << std::endl;
+    }
+
+    if (!consistent) {
+        std::cerr << "Ошибка: ответ по снимку не согласован со снимком" << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,29 @@
+#pragma once
+
+/**
+ * Наборы векторных инструкций, доступные на текущем процессоре
+ * Определяются через CPUID один раз при первом обращении и дальше не меняются
+ */
+struct CpuFeatures {
+    bool sse42 = false;
+    bool avx2 = false;
+    bool avx512f = false;
+};
+
+/**
+ * Получить наборы инструкций текущего процессора
+ * Проверка CPUID выполняется один раз (инициализация статической переменной потокобезопасна)
+ */
+inline const CpuFeatures& cpu_features() {
+    static const CpuFeatures features = [] {
+        CpuFeatures f;
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+        __builtin_cpu_init();
+        f.sse42 = __builtin_cpu_supports("sse4.2");
+        f.avx2 = __builtin_cpu_supports("avx2");
+        f.avx512f = __builtin_cpu_supports("avx512f");
+#endif
+        return f;
+    }();
+    return features;
+}
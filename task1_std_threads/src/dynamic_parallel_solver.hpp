@@ -0,0 +1,164 @@
+#pragma once
+
+#include "base_solver.hpp"
+#include "simd_search.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <future>
+#include <limits>
+#include <thread>
+#include <optional>
+#include <vector>
+
+
+/**
+ * Параллельная реализация задачи с динамической раздачей блоков слева направо
+ *
+ * При статическом разбиении (ParallelSolver, AtomicParallelSolver) поток 0 получает начало массива,
+ * а остальные потоки просматривают далёкие правые части, которые оказываются бесполезными,
+ * если нужный элемент находится в начале. Здесь все потоки идут по массиву вместе:
+ *
+ * Суть:
+ *   - массив делится на небольшие блоки по chunk_size элементов
+ *   - общий атомарный курсор next_chunk_start_ выдаёт блоки строго по возрастанию индекса (fetch_add)
+ *   - блок, начинающийся правее уже найденного индекса, не выдаётся - поток завершает работу
+ *   - найденный индекс публикуется циклом CAS-min в global_min_index_
+ *   - локальные результаты возвращаются через promise/future, итог - минимум из них
+ *
+ * Время до первого совпадения на позиции p - примерно p / число_потоков, а не p
+ */
+template<typename T>
+class DynamicParallelSolver : public BaseSolver<T> {
+public:
+    /**
+     * Конструктор
+     * @param num_threads количество потоков (опционально, если не указано - используется значение hardware_concurrency)
+     * @param chunk_size размер блока, выдаваемого потоку за один раз
+     */
+    explicit DynamicParallelSolver(std::optional<int> num_threads = std::nullopt, std::size_t chunk_size = 4096)
+        : chunk_size_(std::max<std::size_t>(chunk_size, 1)) {
+        if (num_threads.has_value()) {
+            num_threads_ = num_threads.value();
+        } else {
+            auto hc = std::thread::hardware_concurrency();
+            if (hc == 0) {
+                num_threads_ = 2; // fallback на случай, если hardware_concurrency не работает
+            } else {
+                num_threads_ = hc;
+            }
+        }
+    }
+
+private:
+    // Значение global_min_index_, означающее "ничего не найдено"
+    static constexpr std::size_t kNotFound = std::numeric_limits<std::size_t>::max();
+
+public:
+    std::optional<T> solve(std::span<const T> arr, T threshold) override {
+        if (arr.empty()) {
+            return std::nullopt;
+        }
+
+        // Больше потоков, чем блоков, запускать бессмысленно
+        std::size_t num_chunks = (arr.size() + chunk_size_ - 1) / chunk_size_;
+        int actual_threads = static_cast<int>(std::min<std::size_t>(num_threads_, num_chunks));
+
+        // Сбрасываем состояние предыдущего вызова
+        next_chunk_start_.store(0, std::memory_order_relaxed);
+        global_min_index_.store(kNotFound, std::memory_order_relaxed);
+
+        std::vector<std::thread> threads;
+        std::vector<std::future<std::size_t>> futures;
+        threads.reserve(actual_threads);
+        futures.reserve(actual_threads);
+
+        for (int i = 0; i < actual_threads; i++) {
+            std::promise<std::size_t> promise;
+            futures.push_back(promise.get_future());
+            threads.emplace_back(
+                &DynamicParallelSolver::worker_thread,
+                this,
+                arr,
+                threshold,
+                std::move(promise)
+            );
+        }
+
+        // Редукция по минимуму из локальных индексов, полученных через future
+        std::size_t min_index = kNotFound;
+        for (auto& future : futures) {
+            min_index = std::min(min_index, future.get());
+        }
+
+        for (auto& thread : threads) {
+            thread.join();
+        }
+
+        // Элемент, больший порога, не найден
+        if (min_index == kNotFound) {
+            return std::nullopt;
+        }
+
+        return arr[min_index];
+    }
+
+    std::string get_name() const override {
+        return "Параллельная версия (динамическая раздача блоков, " + std::to_string(num_threads_) + " потоков)";
+    }
+
+private:
+    /**
+     * Функция, выполняемая каждым потоком: берёт блоки из общего курсора, пока они нужны
+     *
+     * @param arr ссылка на массив данных
+     * @param threshold пороговое значение
+     * @param result_promise promise для возврата минимального индекса, найденного этим потоком
+     */
+    void worker_thread(std::span<const T> arr, T threshold, std::promise<std::size_t>&& result_promise) {
+        std::size_t local_min_index = kNotFound;
+
+        while (true) {
+            std::size_t chunk_start = next_chunk_start_.fetch_add(chunk_size_, std::memory_order_relaxed);
+            // Блоки кончились, либо блок целиком правее уже найденного элемента
+            // (все последующие блоки будут ещё правее - можно выходить)
+            if (chunk_start >= arr.size() ||
+                chunk_start > global_min_index_.load(std::memory_order_relaxed)) {
+                break;
+            }
+
+            std::size_t chunk_end = std::min(chunk_start + chunk_size_, arr.size());
+            std::size_t chunk_len = chunk_end - chunk_start;
+            std::size_t offset = find_first_greater(arr.data() + chunk_start, chunk_len, threshold);
+            if (offset != chunk_len) {
+                local_min_index = chunk_start + offset;
+                publish_min_index(local_min_index);
+            }
+
+            // Блоки выдаются по возрастанию, поэтому все следующие блоки этого потока
+            // правее найденного элемента
+            if (local_min_index != kNotFound) {
+                break;
+            }
+        }
+
+        result_promise.set_value(local_min_index);
+    }
+
+    /**
+     * Атомарно заменить global_min_index_ на index, если index меньше текущего значения (CAS-min)
+     */
+    void publish_min_index(std::size_t index) {
+        std::size_t current = global_min_index_.load(std::memory_order_relaxed);
+        while (index < current &&
+               !global_min_index_.compare_exchange_weak(current, index, std::memory_order_relaxed)) {
+            // current обновлён compare_exchange_weak - пробуем снова
+        }
+    }
+
+private:
+    int num_threads_;
+    std::size_t chunk_size_;
+    std::atomic<std::size_t> next_chunk_start_ = 0;
+    std::atomic<std::size_t> global_min_index_ = kNotFound;
+};
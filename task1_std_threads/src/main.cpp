@@ -1,28 +1,94 @@
 #include "sequential_solver.hpp"
 #include "parallel_solver.hpp"
+#include "atomic_parallel_solver.hpp"
+#include "pool_parallel_solver.hpp"
+#include "dynamic_parallel_solver.hpp"
+#include "adaptive_solver.hpp"
+#include "numa_parallel_solver.hpp"
+#include "simd_solver.hpp"
+#include "prefix_max_solver.hpp"
+#include "segment_tree_solver.hpp"
+#include "range_query_solver.hpp"
+#include "mapped_file.hpp"
+#include "query_server.hpp"
+#include "stream_engine.hpp"
+#include "workload.hpp"
 
+#include <csignal>
+#include <cstdint>
 #include <cstdlib>
 
 #include <algorithm>
+#include <chrono>
 #include <iostream>
 #include <memory>
 #include <optional>
 #include <random>
+#include <span>
+#include <string>
 #include <vector>
 
 void print_usage(const char* prog_name) {
-    std::cout << "Использование: " << prog_name << " [количество_потоков]" << std::endl;
+    std::cout << "Использование: " << prog_name << " [количество_потоков] [реализация] [--input файл.bin] [--seed N]"
+              << " [--pattern шаблон] [--match-pos доля|none] [--density доля] [--first-k K]"
+              << " [--serve stdin|путь.sock] [--max-batch N] [--stream] [--summary N]" << std::endl;
     std::string usage = R"(
 Программа находит первое число в массиве, превышающее заданное значение
-Массив заполняется случайными числами типа long long
+Массив заполняется случайными числами типа long long либо читается из бинарного файла
 Параметры:
   0                             - использовать последовательную версию
   N [положительное целое число] - использовать параллельную версию с N потоками
   не указано                    - использовать дефолтное количество потоков
+Реализация параллельной версии:
+  mutex                         - общий индекс под mutex (по умолчанию)
+  atomic                        - общий индекс в std::atomic, без блокировок
+  pool                          - как atomic, но поверх постоянного пула потоков
+  dynamic                       - блоки раздаются всем потокам по очереди слева направо
+  numa                          - потоки привязаны к узлам NUMA, каждый узел заполняет (first touch) и просматривает
+                                  свою часть массива; печатается пропускная способность по узлам
+  adaptive                      - на каждый вызов выбирает последовательный, SIMD или поиск на части потоков
+                                  по откалиброванной модели стоимости (N - наибольшее число потоков)
+  simd                          - однопоточный поиск на векторных инструкциях (число потоков игнорируется)
+  prefix                        - индекс префиксных максимумов + бинарный поиск (потоки строят индекс)
+  segtree                       - дерево отрезков по максимуму + спуск (потоки строят дерево)
+  range                         - разреженная таблица максимумов блоков для запросов по подотрезкам [l, r)
+                                  (потоки строят таблицу; здесь - один запрос по всему массиву)
+Опции:
+  --input файл.bin              - искать в файле из 64-битных целых (отображается в память без копирования)
+  --seed N                      - зерно генератора случайного массива (по умолчанию случайное)
+  --pattern шаблон              - как заполнять массив:
+                                    random      - случайные числа по всему диапазону (по умолчанию)
+                                    planted     - фон не больше порога, первое совпадение на заданной позиции
+                                    sorted      - возрастающая последовательность, пересекающая порог на заданной позиции
+                                    reverse     - убывающий фон не больше порога, совпадения как в planted
+                                    adversarial - фон ровно равен порогу, совпадения как в planted
+  --match-pos доля|none         - позиция первого совпадения как доля размера массива (по умолчанию 0.5), none - совпадений нет
+  --density доля                - доля совпадений среди элементов после первого (по умолчанию 0)
+  --first-k K                   - дополнительно вывести первые K элементов больше порога и общее число таких элементов
+                                  (параллельный подсчёт + запись по префиксным суммам)
+  --serve stdin|путь.sock       - режим сервера: массив готовится один раз, затем пороги читаются построчно
+                                  из stdin (ответы - в stdout) или из Unix domain socket; по умолчанию реализация pool.
+                                  Строка запроса - один или несколько порогов через пробел, ответ - по числу на порог
+                                  или none. Все служебные сообщения идут в stderr. Остановка - конец ввода или SIGINT/SIGTERM
+  --max-batch N                 - наибольшее число порогов в одной микропорции сервера (по умолчанию 4096)
+  --stream                      - дополнительно подать массив в потоковый движок порциями по 4096 значений
+                                  с подпиской на порог и вывести глобальный индекс первого совпадения
+  --summary N                   - дополнительно построить сводку максимумов по блокам из N элементов, подключить её
+                                  к решателю (только последовательная версия и mutex) и сравнить время и результат
+                                  с обычным проходом
 )";
     std::cout << usage << std::endl;
 }
 
+// Сервер, которому обработчик SIGINT/SIGTERM передаёт просьбу остановиться
+QueryServer<long long>* g_server = nullptr;
+
+void handle_stop_signal(int) {
+    if (g_server != nullptr) {
+        g_server->request_stop();
+    }
+}
+
 void print_description() {
     std::string description = R"(
 Индивидуальный номер: 51
@@ -37,57 +103,382 @@ void print_description() {
 int main(int argc, char* argv[]) {
     // nullopt означает использовать дефолтное значение числа потоков
     std::optional<int> num_threads = std::nullopt;
+    std::string implementation = "mutex";
 
-    // Обработка аргументов командной строки
-    if (argc > 2) {
+    // путь к бинарному файлу с данными; пустая строка - массив генерируется случайно
+    std::string input_path;
+    // зерно генератора; nullopt - взять из std::random_device
+    std::optional<std::uint64_t> seed = std::nullopt;
+    // шаблон заполнения массива (позиция первого совпадения, плотность совпадений)
+    WorkloadSpec<long long> workload;
+    // сколько первых совпадений вывести (--first-k); nullopt - не выводить
+    std::optional<std::size_t> first_k = std::nullopt;
+    // режим сервера: "stdin" или путь к Unix domain socket; пустая строка - обычный запуск
+    std::string serve;
+    std::size_t max_batch = 4096;
+    // прогнать массив через потоковый движок (--stream)
+    bool stream = false;
+    // размер блока сводки максимумов (--summary); nullopt - сводку не строить
+    std::optional<std::size_t> summary_block = std::nullopt;
+
+    // Обработка аргументов командной строки: опции вида --name значение и позиционные аргументы
+    std::vector<std::string> positional;
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "-h" || arg == "--help") {
+            print_usage(argv[0]);
+            return 0;
+        }
+        if (arg == "--input") {
+            if (i + 1 >= argc) {
+                std::cerr << "Ошибка: после --input нужно указать путь к файлу" << std::endl;
+                print_usage(argv[0]);
+                return 1;
+            }
+            input_path = argv[++i];
+        } else if (arg == "--seed") {
+            if (i + 1 >= argc) {
+                std::cerr << "Ошибка: после --seed нужно указать число" << std::endl;
+                print_usage(argv[0]);
+                return 1;
+            }
+            seed = std::strtoull(argv[++i], nullptr, 10);
+        } else if (arg == "--serve" || arg == "--max-batch") {
+            if (i + 1 >= argc) {
+                std::cerr << "Ошибка: после " << arg << " нужно указать значение" << std::endl;
+                print_usage(argv[0]);
+                return 1;
+            }
+            if (arg == "--serve") {
+                serve = argv[++i];
+            } else {
+                max_batch = std::strtoull(argv[++i], nullptr, 10);
+            }
+        } else if (arg == "--stream") {
+            stream = true;
+        } else if (arg == "--summary") {
+            if (i + 1 >= argc) {
+                std::cerr << "Ошибка: после --summary нужно указать размер блока" << std::endl;
+                print_usage(argv[0]);
+                return 1;
+            }
+            summary_block = std::max<std::size_t>(std::strtoull(argv[++i], nullptr, 10), 1);
+        } else if (arg == "--first-k") {
+            if (i + 1 >= argc) {
+                std::cerr << "Ошибка: после --first-k нужно указать число" << std::endl;
+                print_usage(argv[0]);
+                return 1;
+            }
+            first_k = std::strtoull(argv[++i], nullptr, 10);
+        } else if (arg == "--pattern" || arg == "--match-pos" || arg == "--density") {
+            if (i + 1 >= argc) {
+                std::cerr << "Ошибка: после " << arg << " нужно указать значение" << std::endl;
+                print_usage(argv[0]);
+                return 1;
+            }
+            std::string value = argv[++i];
+            if (arg == "--pattern") {
+                auto pattern = parse_workload_pattern(value);
+                if (!pattern.has_value()) {
+                    std::cerr << "Ошибка: неизвестный шаблон " << value << std::endl;
+                    print_usage(argv[0]);
+                    return 1;
+                }
+                workload.pattern = pattern.value();
+            } else if (arg == "--match-pos") {
+                workload.match_position = (value == "none") ? std::nullopt : std::optional<double>(std::atof(value.c_str()));
+            } else {
+                workload.density = std::atof(value.c_str());
+            }
+        } else {
+            positional.push_back(arg);
+        }
+    }
+    if (positional.size() > 2) {
         std::cerr << "Ошибка: слишком много аргументов" << std::endl;
         print_usage(argv[0]);
         return 1;
     }
-    if (argc == 2) {
-        if (std::string(argv[1]) == "-h" || std::string(argv[1]) == "--help") {
-            print_usage(argv[0]);
-            return 0;
-        }
-        num_threads = std::atoi(argv[1]);
+    if (positional.size() >= 1) {
+        num_threads = std::atoi(positional[0].c_str());
         if (num_threads.value() < 0) {
             std::cerr << "Ошибка: число потоков не может быть отрицательным" << std::endl;
             print_usage(argv[0]);
             return 1;
         }
     }
+    if (positional.size() == 2) {
+        implementation = positional[1];
+        if (implementation != "mutex" && implementation != "atomic" && implementation != "pool" &&
+            implementation != "dynamic" && implementation != "adaptive" && implementation != "numa" &&
+            implementation != "simd" &&
+            implementation != "prefix" && implementation != "segtree" && implementation != "range") {
+            std::cerr << "Ошибка: неизвестная реализация " << implementation << std::endl;
+            print_usage(argv[0]);
+            return 1;
+        }
+    }
+
+    if (!serve.empty()) {
+        // Серверу нужен тёплый решатель: без явного выбора - пул потоков
+        if (positional.size() < 2) {
+            implementation = "pool";
+        }
+        // В режиме stdin stdout занят ответами, поэтому все сообщения программы уходят в stderr
+        std::cout.rdbuf(std::cerr.rdbuf());
+    }
 
     print_description();
     
     std::unique_ptr<BaseSolver<long long>> solver;
+    // Для numa массив заполняется потоками решателя, а после поиска печатается статистика по узлам
+    NumaParallelSolver<long long>* numa_solver = nullptr;
+    // К последовательной версии и mutex можно подключить сводку максимумов по блокам (--summary)
+    SequentialSolver<long long>* sequential_solver = nullptr;
+    ParallelSolver<long long>* mutex_solver = nullptr;
     if (num_threads.has_value() && num_threads.value() == 0) {
-        solver = std::make_unique<SequentialSolver<long long>>();
+        auto sequential = std::make_unique<SequentialSolver<long long>>();
+        sequential_solver = sequential.get();
+        solver = std::move(sequential);
+    } else if (implementation == "simd") {
+        solver = std::make_unique<SimdSolver>();
+    } else if (implementation == "prefix") {
+        solver = std::make_unique<PrefixMaxSolver<long long>>(num_threads);
+    } else if (implementation == "segtree") {
+        solver = std::make_unique<SegmentTreeSolver<long long>>(num_threads);
+    } else if (implementation == "range") {
+        solver = std::make_unique<RangeQuerySolver<long long>>(num_threads);
+    } else if (implementation == "atomic") {
+        solver = std::make_unique<AtomicParallelSolver<long long>>(num_threads);
+    } else if (implementation == "pool") {
+        solver = std::make_unique<PoolParallelSolver<long long>>(num_threads);
+    } else if (implementation == "dynamic") {
+        solver = std::make_unique<DynamicParallelSolver<long long>>(num_threads);
+    } else if (implementation == "adaptive") {
+        solver = std::make_unique<AdaptiveSolver<long long>>(num_threads);
+    } else if (implementation == "numa") {
+        auto numa = std::make_unique<NumaParallelSolver<long long>>(num_threads);
+        numa_solver = numa.get();
+        solver = std::move(numa);
     } else {
-        solver = std::make_unique<ParallelSolver<long long>>(num_threads);
+        auto mutex = std::make_unique<ParallelSolver<long long>>(num_threads);
+        mutex_solver = mutex.get();
+        solver = std::move(mutex);
+    }
+    if (summary_block.has_value() && sequential_solver == nullptr && mutex_solver == nullptr) {
+        std::cerr << "Ошибка: --summary поддерживают только последовательная версия и mutex" << std::endl;
+        print_usage(argv[0]);
+        return 1;
     }
     std::cout << "Выбранная Вами реализация: " << solver->get_name() << std::endl;
     
     // Параметры задачи
     constexpr size_t array_size = 10000000;
     constexpr long long threshold = 5000000;
+
+    // Данные: либо отображённый в память файл, либо сгенерированный массив
+    // Решатели в обоих случаях получают std::span без копирования
+    std::unique_ptr<MappedFile> mapped_file;
+    std::unique_ptr<long long[]> generated;
+    std::span<const long long> arr;
+
     std::cout << "========================================" << std::endl;
-    std::cout << "Размер массива:     " << array_size << std::endl;
-    std::cout << "Пороговое значение: " << threshold << std::endl;
-    std::cout << "Массив будет заполнен случайными числами" << std::endl;
-    // Создаём массив случайных чисел
-    std::vector<long long> arr(array_size);
-    std::random_device rd;
-    std::mt19937 gen(rd());
-    std::uniform_int_distribution<long long> distr(std::numeric_limits<long long>::min(), std::numeric_limits<long long>::max());
-    std::generate(arr.begin(), arr.end(), [&]() { return distr(gen); });
+    if (!input_path.empty()) {
+        mapped_file = MappedFile::open(input_path, sizeof(long long));
+        if (!mapped_file) {
+            return 1;
+        }
+        arr = mapped_file->as_span<long long>();
+        std::cout << "Входной файл:       " << input_path << std::endl;
+        std::cout << "Размер массива:     " << arr.size() << std::endl;
+        std::cout << "Пороговое значение: " << threshold << std::endl;
+    } else {
+        std::cout << "Размер массива:     " << array_size << std::endl;
+        std::cout << "Пороговое значение: " << threshold << std::endl;
+        if (!seed.has_value()) {
+            std::random_device rd;
+            seed = (static_cast<std::uint64_t>(rd()) << 32) | rd();
+        }
+        std::cout << "Массив будет заполнен случайными числами (seed = " << seed.value() << ")" << std::endl;
+        if (workload.pattern != WorkloadPattern::Random) {
+            std::size_t first_match = planted_index(workload, array_size);
+            std::cout << "Первое совпадение:  ";
+            if (first_match == array_size) {
+                std::cout << "нет" << std::endl;
+            } else {
+                std::cout << "индекс " << first_match << std::endl;
+            }
+        }
+        // Создаём массив случайных чисел: параллельно, на счётчиковом генераторе,
+        // каждый поток первым касается своей части массива
+        workload.threshold = threshold;
+        workload.seed = seed.value();
+        std::optional<int> fill_threads = (num_threads.has_value() && num_threads.value() > 0) ? num_threads : std::nullopt;
+        if (numa_solver != nullptr) {
+            // Каждую часть массива первым касается поток того узла, который будет её просматривать
+            generated = std::make_unique_for_overwrite<long long[]>(array_size);
+            numa_solver->fill(std::span<long long>(generated.get(), array_size),
+                              [&workload](std::size_t i) { return workload_value(workload, array_size, i); });
+        } else {
+            generated = make_workload_array<long long>(array_size, workload, fill_threads);
+        }
+        arr = std::span<const long long>(generated.get(), array_size);
+    }
     std::cout << "========================================" << std::endl;
         
+    if (!serve.empty()) {
+        // Индексные решатели перестраивают индекс в каждом solve_many - серверу индекс строится один раз,
+        // а микропорции отвечаются запросами к нему
+        std::unique_ptr<BaseSolver<long long>> prebuilt;
+        using clock = std::chrono::steady_clock;
+        auto build_start = clock::now();
+        if (auto* prefix = dynamic_cast<PrefixMaxSolver<long long>*>(solver.get())) {
+            prefix->build(arr);
+            prebuilt = std::make_unique<PrebuiltIndexSolver<long long>>(
+                [prefix](long long t) { return prefix->query(t); }, prefix->get_name());
+        } else if (auto* segtree = dynamic_cast<SegmentTreeSolver<long long>*>(solver.get())) {
+            segtree->build(arr);
+            prebuilt = std::make_unique<PrebuiltIndexSolver<long long>>(
+                [segtree](long long t) -> std::optional<long long> {
+                    std::size_t index = segtree->first_greater(t);
+                    if (index == SegmentTreeSolver<long long>::kNotFound) {
+                        return std::nullopt;
+                    }
+                    return segtree->value(index);
+                },
+                segtree->get_name());
+        } else if (auto* range = dynamic_cast<RangeQuerySolver<long long>*>(solver.get())) {
+            range->build(arr);
+            std::size_t n = arr.size();
+            prebuilt = std::make_unique<PrebuiltIndexSolver<long long>>(
+                [range, n](long long t) -> std::optional<long long> {
+                    auto answer = range->query(0, n, t);
+                    if (!answer.has_value()) {
+                        return std::nullopt;
+                    }
+                    return answer->value;
+                },
+                range->get_name());
+        }
+        if (prebuilt) {
+            std::cout << "Индекс построен за " << std::chrono::duration<double, std::milli>(clock::now() - build_start).count()
+                      << " мс" << std::endl;
+        }
+
+        QueryServer<long long> server(arr, prebuilt ? *prebuilt : *solver, max_batch);
+        g_server = &server;
+        // Без SA_RESTART: сигнал прерывает блокирующий read, и сервер видит просьбу остановиться
+        struct sigaction action {};
+        action.sa_handler = handle_stop_signal;
+        sigemptyset(&action.sa_mask);
+        sigaction(SIGINT, &action, nullptr);
+        sigaction(SIGTERM, &action, nullptr);
+
+        bool ok = true;
+        if (serve == "stdin") {
+            std::cout << "Сервер читает пороги из stdin" << std::endl;
+            server.serve_stream(STDIN_FILENO, STDOUT_FILENO);
+        } else {
+            std::cout << "Сервер слушает " << serve << std::endl;
+            ok = server.serve_unix_socket(serve);
+        }
+        g_server = nullptr;
+
+        std::cout << "Обработано порогов: " << server.queries_served()
+                  << ", вызовов solve_many: " << server.batches_served() << std::endl;
+        return ok ? 0 : 1;
+    }
+
     auto result = solver->solve(arr, threshold);
     if (result.has_value()) {
         std::cout << "Найденное значение: " << result.value() << std::endl;
     } else {
         std::cout << "Элемент не найден :(" << std::endl;
     }
+
+    if (summary_block.has_value()) {
+        // Тот же решатель с подключённой сводкой; ответ сверяется с обычным проходом
+        using clock = std::chrono::steady_clock;
+        auto millis = [](clock::duration d) {
+            return std::chrono::duration<double, std::milli>(d).count();
+        };
+        auto start = clock::now();
+        auto plain = solver->solve(arr, threshold);
+        double plain_time = millis(clock::now() - start);
+
+        BlockMaxSummary<long long> summary(summary_block.value());
+        start = clock::now();
+        summary.build(arr);
+        double build_time = millis(clock::now() - start);
+
+        auto attach = [&](const BlockMaxSummary<long long>* s) {
+            if (sequential_solver != nullptr) {
+                sequential_solver->attach_summary(s);
+            } else {
+                mutex_solver->attach_summary(s);
+            }
+        };
+        attach(&summary);
+        start = clock::now();
+        auto summarized = solver->solve(arr, threshold);
+        double summary_time = millis(clock::now() - start);
+        attach(nullptr);
+
+        std::cout << "========================================" << std::endl;
+        std::cout << "Сводка по блокам из " << summary.block_size() << " элементов: построение " << build_time << " мс" << std::endl;
+        std::cout << "Поиск без сводки: " << plain_time << " мс, со сводкой: " << summary_time << " мс" << std::endl;
+        if (summarized != plain) {
+            std::cerr << "Ошибка: результат со сводкой не совпадает с обычным проходом" << std::endl;
+            return 1;
+        }
+    }
+
+    if (first_k.has_value()) {
+        // Отбор всегда параллельный, независимо от выбранной реализации поиска первого элемента
+        std::optional<int> select_threads = (num_threads.has_value() && num_threads.value() > 0) ? num_threads : std::nullopt;
+        AtomicParallelSolver<long long> selector(select_threads);
+        std::vector<long long> first_values = selector.solve_first_k(arr, threshold, first_k.value());
+        std::size_t total = selector.count_greater(arr, threshold);
+
+        std::cout << "========================================" << std::endl;
+        std::cout << "Первые " << first_values.size() << " элементов больше порога:";
+        for (long long value : first_values) {
+            std::cout << " " << value;
+        }
+        std::cout << std::endl;
+        std::cout << "Всего элементов больше порога: " << total << std::endl;
+    }
+
+    if (stream) {
+        // Массив поступает порциями, как из внешнего источника; движок проверяет каждое значение один раз
+        using clock = std::chrono::steady_clock;
+        StreamEngine<long long> engine;
+        engine.subscribe(threshold);
+        auto start = clock::now();
+        constexpr std::size_t piece = 4096;
+        for (std::size_t i = 0; i < arr.size(); i += piece) {
+            engine.push(arr.subspan(i, std::min(piece, arr.size() - i)));
+        }
+        engine.flush();
+        double seconds = std::chrono::duration<double>(clock::now() - start).count();
+
+        std::cout << "========================================" << std::endl;
+        auto matches = engine.take_matches();
+        if (matches.empty()) {
+            std::cout << "Поток: совпадений нет" << std::endl;
+        } else {
+            std::cout << "Поток: значение " << matches.front().value << " на глобальном индексе " << matches.front().index << std::endl;
+        }
+        std::cout << "Поток: проверено " << engine.values_checked() << " значений за " << seconds * 1e3 << " мс" << std::endl;
+    }
+
+    if (numa_solver != nullptr) {
+        std::cout << "========================================" << std::endl;
+        for (const auto& stats : numa_solver->node_stats()) {
+            std::cout << "Узел " << stats.node_id << ": потоков " << stats.threads
+                      << ", прочитано " << stats.bytes_scanned << " байт, " << stats.gbps() << " ГБ/с" << std::endl;
+        }
+    }
     
     return 0;
 }
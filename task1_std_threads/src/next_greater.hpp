@@ -0,0 +1,174 @@
+#pragma once
+
+#include "chunking.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <optional>
+#include <span>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * Ближайший больший справа (all nearest larger values): для каждой позиции i - наименьший j > i
+ * с arr[j] > arr[i], или arr.size(), если такого нет
+ */
+
+/**
+ * Последовательный алгоритм со стеком за O(n): стек хранит позиции, для которых ответ ещё не найден;
+ * их значения не возрастают от дна к вершине. Очередной элемент снимает со стека все меньшие себя -
+ * для них он и есть ближайший больший справа
+ */
+template<typename T>
+void next_greater_serial(std::span<const T> arr, std::span<std::size_t> out) {
+    std::vector<std::size_t> stack;
+    for (std::size_t j = 0; j < arr.size(); j++) {
+        while (!stack.empty() && arr[stack.back()] < arr[j]) {
+            out[stack.back()] = j;
+            stack.pop_back();
+        }
+        stack.push_back(j);
+    }
+    for (std::size_t i : stack) {
+        out[i] = arr.size();
+    }
+}
+
+/**
+ * Параллельный поиск ближайшего большего справа (std::thread)
+ *
+ * Суть:
+ *   1. массив делится на части по потокам (split_into_chunks); каждый поток проходит свою часть
+ *      последовательным алгоритмом со своим стеком. В конце на стеке остаются позиции без большего справа
+ *      внутри части - их значения не возрастают слева направо. Заодно поток запоминает записи префиксного
+ *      максимума части: позиции, где максимум от начала части строго растёт
+ *   2. ответ для позиции, оставшейся на стеке части c со значением v, - первый элемент больше v в частях правее:
+ *      это первая часть d > c с максимумом больше v, а внутри неё - первая запись префиксного максимума больше v
+ *      (бинарный поиск по возрастающим значениям записей). Стек обходится от вершины ко дну, то есть по
+ *      неубыванию v, поэтому и номер части d, и позиция в записях только растут - два указателя
+ *
+ * Оба прохода параллельны; последовательная часть - только обмен максимумами частей между проходами.
+ * Дополнительная память - стеки и записи частей, в худшем случае (убывающий или возрастающий массив) O(n)
+ */
+template<typename T>
+class NextGreaterSolver {
+public:
+    /**
+     * Конструктор
+     * @param num_threads количество потоков (опционально, если не указано - используется значение hardware_concurrency)
+     */
+    explicit NextGreaterSolver(std::optional<int> num_threads = std::nullopt) {
+        if (num_threads.has_value()) {
+            num_threads_ = std::max(num_threads.value(), 1);
+        } else {
+            auto hc = std::thread::hardware_concurrency();
+            if (hc == 0) {
+                num_threads_ = 2; // fallback на случай, если hardware_concurrency не работает
+            } else {
+                num_threads_ = hc;
+            }
+        }
+    }
+
+    /**
+     * Записать в out[i] ближайший больший справа для каждого i (out.size() == arr.size())
+     */
+    void solve(std::span<const T> arr, std::span<std::size_t> out) const {
+        std::size_t parts = std::min<std::size_t>(static_cast<std::size_t>(num_threads_), arr.size());
+        if (parts <= 1) {
+            next_greater_serial(arr, out);
+            return;
+        }
+        std::vector<ChunkRange> chunks = split_into_chunks(arr.size(), parts);
+
+        // Проход 1: локальные стеки и записи префиксного максимума каждой части
+        std::vector<std::vector<std::size_t>> stacks(parts);
+        std::vector<std::vector<std::size_t>> records(parts);
+        run_parallel(parts, [&](std::size_t c) {
+            const ChunkRange& chunk = chunks[c];
+            std::vector<std::size_t>& stack = stacks[c];
+            std::vector<std::size_t>& chunk_records = records[c];
+            for (std::size_t j = chunk.begin; j < chunk.end; j++) {
+                T value = arr[j];
+                while (!stack.empty() && arr[stack.back()] < value) {
+                    out[stack.back()] = j;
+                    stack.pop_back();
+                }
+                stack.push_back(j);
+                if (chunk_records.empty() || arr[chunk_records.back()] < value) {
+                    chunk_records.push_back(j);
+                }
+            }
+        });
+
+        // Максимум части - значение её последней записи
+        std::vector<T> chunk_max(parts);
+        for (std::size_t c = 0; c < parts; c++) {
+            chunk_max[c] = arr[records[c].back()];
+        }
+
+        // Проход 2: позиции, оставшиеся на стеках, ищут ответ в частях правее
+        run_parallel(parts, [&](std::size_t c) {
+            const std::vector<std::size_t>& stack = stacks[c];
+            std::size_t d = c + 1;
+            std::size_t record_pos = 0;
+            // От вершины стека ко дну - значения не убывают
+            for (auto it = stack.rbegin(); it != stack.rend(); ++it) {
+                T value = arr[*it];
+                std::size_t next_d = d;
+                while (next_d < parts && chunk_max[next_d] <= value) {
+                    next_d++;
+                }
+                if (next_d == parts) {
+                    // Правее нет ничего больше - и для всех позиций глубже в стеке тоже
+                    for (; it != stack.rend(); ++it) {
+                        out[*it] = arr.size();
+                    }
+                    break;
+                }
+                if (next_d != d) {
+                    d = next_d;
+                    record_pos = 0;
+                }
+                const std::vector<std::size_t>& chunk_records = records[d];
+                auto found = std::upper_bound(chunk_records.begin() + record_pos, chunk_records.end(), value,
+                                              [&arr](T v, std::size_t index) { return v < arr[index]; });
+                record_pos = static_cast<std::size_t>(found - chunk_records.begin());
+                out[*it] = *found;
+            }
+        });
+    }
+
+    /**
+     * То же, с выделением результата
+     */
+    std::vector<std::size_t> solve(std::span<const T> arr) const {
+        std::vector<std::size_t> out(arr.size());
+        solve(arr, out);
+        return out;
+    }
+
+    std::string get_name() const {
+        return "Параллельный ближайший больший справа (std::thread, " + std::to_string(num_threads_) + " потоков)";
+    }
+
+private:
+    /**
+     * Выполнить func(part) для part = 0..num_parts-1 в отдельных потоках и дождаться завершения
+     */
+    template<typename Func>
+    static void run_parallel(std::size_t num_parts, Func func) {
+        std::vector<std::thread> threads;
+        threads.reserve(num_parts);
+        for (std::size_t part = 0; part < num_parts; part++) {
+            threads.emplace_back(func, part);
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+    }
+
+private:
+    int num_threads_;
+};
@@ -0,0 +1,270 @@
+#pragma once
+
+#include "base_solver.hpp"
+#include "numa_topology.hpp"
+#include "simd_search.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <future>
+#include <limits>
+#include <optional>
+#include <thread>
+#include <vector>
+
+
+/**
+ * Статистика узла NUMA, накопленная решателем: сколько байт прочитали его потоки и за какое время
+ * Если разбиение и first touch работают, пропускная способность узлов примерно одинакова;
+ * узел, читающий чужую память, заметно отстаёт
+ */
+struct NumaNodeStats {
+    int node_id = 0;
+    std::size_t threads = 0;
+    std::uint64_t bytes_scanned = 0;
+    double seconds = 0;
+
+    double gbps() const {
+        return seconds > 0 ? static_cast<double>(bytes_scanned) / seconds / 1e9 : 0;
+    }
+};
+
+/**
+ * Параллельная реализация задачи с учётом NUMA
+ *
+ * На многосокетной машине потоки ParallelSolver оказываются где угодно, а массив, заполненный одним потоком,
+ * целиком лежит в памяти одного узла - половина потоков читает чужую память через межсокетную шину
+ *
+ * Суть:
+ *   - потоки распределяются по узлам поровну и привязываются к процессорам своего узла (pthread_setaffinity_np)
+ *   - массив делится на непрерывные части по потокам в порядке узлов, так что каждому узлу достаётся
+ *     непрерывный отрезок массива
+ *   - fill заполняет массив теми же потоками по тому же разбиению: каждая страница впервые записывается (first touch)
+ *     потоком того узла, который будет её просматривать, и ядро выделяет её в памяти этого узла
+ *   - поиск - как в AtomicParallelSolver: блоки по block_size элементов, общий индекс с CAS-min
+ *   - по каждому узлу копится статистика прочитанных байт и времени (node_stats)
+ *
+ * На машине с одним узлом потоки не привязываются, и решатель ведёт себя как AtomicParallelSolver
+ */
+template<typename T>
+class NumaParallelSolver : public BaseSolver<T> {
+public:
+    /**
+     * Конструктор
+     * @param num_threads количество потоков (опционально, если не указано - число разрешённых процессоров)
+     * @param topology топология NUMA (по умолчанию определяется по sysfs)
+     * @param block_size сколько элементов просматривается между проверками глобального индекса
+     */
+    explicit NumaParallelSolver(std::optional<int> num_threads = std::nullopt,
+                                NumaTopology topology = NumaTopology::detect(),
+                                std::size_t block_size = 4096)
+        : topology_(std::move(topology)), block_size_(std::max<std::size_t>(block_size, 1)) {
+        std::size_t total_cpus = 0;
+        for (const auto& node : topology_.nodes()) {
+            total_cpus += node.cpus.size();
+        }
+        if (num_threads.has_value()) {
+            num_threads_ = std::max(num_threads.value(), 1);
+        } else {
+            num_threads_ = std::max<int>(static_cast<int>(total_cpus), 1);
+        }
+
+        // Потоки раздаются узлам подряд: первые threads_on_node(0) потоков - узлу 0, следующие - узлу 1 и т.д.,
+        // чтобы части массива одного узла шли подряд
+        std::size_t nodes = topology_.node_count();
+        for (std::size_t n = 0; n < nodes; n++) {
+            std::size_t threads_on_node = num_threads_ / nodes + (n < num_threads_ % nodes ? 1 : 0);
+            for (std::size_t t = 0; t < threads_on_node; t++) {
+                worker_nodes_.push_back(n);
+            }
+        }
+
+        node_stats_.resize(nodes);
+        for (std::size_t n = 0; n < nodes; n++) {
+            node_stats_[n].node_id = topology_.nodes()[n].id;
+            node_stats_[n].threads = static_cast<std::size_t>(std::count(worker_nodes_.begin(), worker_nodes_.end(), n));
+        }
+    }
+
+private:
+    // Значение global_min_index_, означающее "ничего не найдено"
+    static constexpr std::size_t kNotFound = std::numeric_limits<std::size_t>::max();
+
+    struct WorkerResult {
+        std::size_t index = kNotFound;
+        std::uint64_t bytes_scanned = 0;
+        double seconds = 0;
+    };
+
+public:
+    std::optional<T> solve(std::span<const T> arr, T threshold) override {
+        if (arr.empty()) {
+            return std::nullopt;
+        }
+
+        std::size_t workers = std::min(worker_nodes_.size(), arr.size());
+
+        // Сбрасываем результат предыдущего вызова
+        global_min_index_.store(kNotFound, std::memory_order_relaxed);
+
+        std::vector<std::thread> threads;
+        std::vector<std::future<WorkerResult>> futures;
+        threads.reserve(workers);
+        futures.reserve(workers);
+
+        for (std::size_t w = 0; w < workers; w++) {
+            std::promise<WorkerResult> promise;
+            futures.push_back(promise.get_future());
+            threads.emplace_back(
+                &NumaParallelSolver::worker_thread,
+                this,
+                arr,
+                threshold,
+                worker_nodes_[w],
+                arr.size() * w / workers,
+                arr.size() * (w + 1) / workers,
+                std::move(promise)
+            );
+        }
+
+        // Редукция по минимуму; время узла - время его самого медленного потока
+        std::size_t min_index = kNotFound;
+        std::vector<double> node_seconds(node_stats_.size(), 0);
+        for (std::size_t w = 0; w < workers; w++) {
+            WorkerResult result = futures[w].get();
+            min_index = std::min(min_index, result.index);
+            node_stats_[worker_nodes_[w]].bytes_scanned += result.bytes_scanned;
+            node_seconds[worker_nodes_[w]] = std::max(node_seconds[worker_nodes_[w]], result.seconds);
+        }
+        for (std::size_t n = 0; n < node_stats_.size(); n++) {
+            node_stats_[n].seconds += node_seconds[n];
+        }
+
+        for (auto& thread : threads) {
+            thread.join();
+        }
+
+        // Элемент, больший порога, не найден
+        if (min_index == kNotFound) {
+            return std::nullopt;
+        }
+
+        return arr[min_index];
+    }
+
+    /**
+     * Заполнить массив out[i] = value_at(i) потоками, привязанными к узлам, по тому же разбиению, что и solve
+     * Для памяти, выделенной без инициализации, это размещает каждую часть на узле, который будет её просматривать
+     */
+    template<typename ValueAt>
+    void fill(std::span<T> out, ValueAt value_at) {
+        std::size_t workers = std::min(worker_nodes_.size(), std::max<std::size_t>(out.size(), 1));
+
+        std::vector<std::thread> threads;
+        threads.reserve(workers);
+        for (std::size_t w = 0; w < workers; w++) {
+            std::size_t begin = out.size() * w / workers;
+            std::size_t end = out.size() * (w + 1) / workers;
+            threads.emplace_back([this, out, &value_at, node = worker_nodes_[w], begin, end] {
+                pin_to_node(node);
+                for (std::size_t i = begin; i < end; i++) {
+                    out[i] = value_at(i);
+                }
+            });
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+    }
+
+    /**
+     * Статистика по узлам, накопленная с создания решателя (или последнего reset_node_stats)
+     */
+    const std::vector<NumaNodeStats>& node_stats() const {
+        return node_stats_;
+    }
+
+    void reset_node_stats() {
+        for (auto& stats : node_stats_) {
+            stats.bytes_scanned = 0;
+            stats.seconds = 0;
+        }
+    }
+
+    const NumaTopology& topology() const {
+        return topology_;
+    }
+
+    std::string get_name() const override {
+        return "Параллельная версия (NUMA, " + std::to_string(num_threads_) + " потоков на "
+               + std::to_string(topology_.node_count()) + " узлах)";
+    }
+
+private:
+    /**
+     * Привязать текущий поток к процессорам узла (на машине с одним узлом - ничего не делать)
+     */
+    void pin_to_node(std::size_t node) const {
+        if (topology_.is_numa()) {
+            pin_current_thread(topology_.nodes()[node].cpus);
+        }
+    }
+
+    /**
+     * Функция, выполняемая каждым потоком: привязаться к узлу и просмотреть свою часть блоками
+     */
+    void worker_thread(
+        std::span<const T> arr,
+        T threshold,
+        std::size_t node,
+        std::size_t start_idx,
+        std::size_t end_idx,
+        std::promise<WorkerResult>&& result_promise
+    ) {
+        using clock = std::chrono::steady_clock;
+        pin_to_node(node);
+
+        WorkerResult result;
+        auto start = clock::now();
+        for (std::size_t block_start = start_idx; block_start < end_idx; block_start += block_size_) {
+            // Другой поток уже нашёл элемент левее - дальше искать бессмысленно
+            if (global_min_index_.load(std::memory_order_relaxed) < block_start) {
+                break;
+            }
+
+            std::size_t block_len = std::min(block_size_, end_idx - block_start);
+            std::size_t offset = find_first_greater(arr.data() + block_start, block_len, threshold);
+            if (offset != block_len) {
+                result.index = block_start + offset;
+                result.bytes_scanned += (offset + 1) * sizeof(T);
+                publish_min_index(result.index);
+                break;
+            }
+            result.bytes_scanned += block_len * sizeof(T);
+        }
+        result.seconds = std::chrono::duration<double>(clock::now() - start).count();
+        result_promise.set_value(result);
+    }
+
+    /**
+     * Атомарно заменить global_min_index_ на index, если index меньше текущего значения (CAS-min)
+     */
+    void publish_min_index(std::size_t index) {
+        std::size_t current = global_min_index_.load(std::memory_order_relaxed);
+        while (index < current &&
+               !global_min_index_.compare_exchange_weak(current, index, std::memory_order_relaxed)) {
+            // current обновлён compare_exchange_weak - пробуем снова
+        }
+    }
+
+private:
+    NumaTopology topology_;
+    std::size_t num_threads_;
+    std::size_t block_size_;
+    // worker_nodes_[w] - индекс узла (в topology_.nodes()) для потока w
+    std::vector<std::size_t> worker_nodes_;
+    std::vector<NumaNodeStats> node_stats_;
+    std::atomic<std::size_t> global_min_index_{kNotFound};
+};
@@ -0,0 +1,183 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <pthread.h>
+#include <sched.h>
+
+/**
+ * Топология NUMA: узлы памяти и процессоры, которые к ним относятся
+ *
+ * Читается из /sys/devices/system/node/node<N>/cpulist (без libnuma).
+ * Учитываются только процессоры, на которых процессу разрешено работать (sched_getaffinity),
+ * узлы без таких процессоров отбрасываются. Если sysfs недоступен (не Linux, контейнер без /sys),
+ * топология вырождается в один узел со всеми разрешёнными процессорами - и всё, что на неё опирается,
+ * работает как обычно, без привязки потоков
+ */
+struct NumaNode {
+    // Номер узла в системе
+    int id = 0;
+    // Процессоры узла, разрешённые процессу
+    std::vector<int> cpus;
+};
+
+/**
+ * Разобрать список процессоров в формате sysfs: "0-3,8-11,16"
+ */
+inline std::vector<int> parse_cpu_list(const std::string& list) {
+    std::vector<int> cpus;
+    std::stringstream ss(list);
+    std::string range;
+    while (std::getline(ss, range, ',')) {
+        if (range.empty() || range == "\n") {
+            continue;
+        }
+        std::size_t dash = range.find('-');
+        int first = std::atoi(range.substr(0, dash).c_str());
+        int last = (dash == std::string::npos) ? first : std::atoi(range.substr(dash + 1).c_str());
+        for (int cpu = first; cpu <= last; cpu++) {
+            cpus.push_back(cpu);
+        }
+    }
+    return cpus;
+}
+
+/**
+ * Процессоры, на которых процессу разрешено работать
+ */
+inline std::vector<int> allowed_cpus() {
+    std::vector<int> cpus;
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    if (sched_getaffinity(0, sizeof(set), &set) == 0) {
+        for (int cpu = 0; cpu < CPU_SETSIZE; cpu++) {
+            if (CPU_ISSET(cpu, &set)) {
+                cpus.push_back(cpu);
+            }
+        }
+    }
+    if (cpus.empty()) {
+        // Маску получить не удалось - считаем, что доступны все процессоры
+        unsigned hc = std::max(std::thread::hardware_concurrency(), 1u);
+        for (unsigned cpu = 0; cpu < hc; cpu++) {
+            cpus.push_back(static_cast<int>(cpu));
+        }
+    }
+    return cpus;
+}
+
+/**
+ * Привязать текущий поток к набору процессоров (pthread_setaffinity_np)
+ * @return true, если привязка удалась
+ */
+inline bool pin_current_thread(const std::vector<int>& cpus) {
+    if (cpus.empty()) {
+        return false;
+    }
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    for (int cpu : cpus) {
+        if (cpu >= 0 && cpu < CPU_SETSIZE) {
+            CPU_SET(cpu, &set);
+        }
+    }
+    return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+}
+
+class NumaTopology {
+public:
+    /**
+     * Определить топологию текущей машины; при неудаче - один узел (single_node)
+     */
+    static NumaTopology detect() {
+        namespace fs = std::filesystem;
+
+        std::vector<int> allowed = allowed_cpus();
+        NumaTopology topology;
+
+        std::error_code ec;
+        for (const auto& entry : fs::directory_iterator("/sys/devices/system/node", ec)) {
+            std::string name = entry.path().filename().string();
+            if (name.rfind("node", 0) != 0 || name.size() == 4 ||
+                !std::all_of(name.begin() + 4, name.end(), [](char ch) { return ch >= '0' && ch <= '9'; })) {
+                continue;
+            }
+            std::ifstream cpulist(entry.path() / "cpulist");
+            std::string list;
+            if (!cpulist || !std::getline(cpulist, list)) {
+                continue;
+            }
+
+            NumaNode node;
+            node.id = std::atoi(name.c_str() + 4);
+            for (int cpu : parse_cpu_list(list)) {
+                if (std::find(allowed.begin(), allowed.end(), cpu) != allowed.end()) {
+                    node.cpus.push_back(cpu);
+                }
+            }
+            // Узлы только с памятью или с запрещёнными процессорами потоки не получают
+            if (!node.cpus.empty()) {
+                topology.nodes_.push_back(std::move(node));
+            }
+        }
+
+        if (topology.nodes_.empty()) {
+            return single_node();
+        }
+        std::sort(topology.nodes_.begin(), topology.nodes_.end(),
+                  [](const NumaNode& a, const NumaNode& b) { return a.id < b.id; });
+        return topology;
+    }
+
+    /**
+     * Вырожденная топология: один узел со всеми разрешёнными процессорами
+     */
+    static NumaTopology single_node() {
+        NumaTopology topology;
+        NumaNode node;
+        node.cpus = allowed_cpus();
+        topology.nodes_.push_back(std::move(node));
+        return topology;
+    }
+
+    /**
+     * Топология из заданного списка узлов - например, чтобы проверить разбиение по узлам на машине с одним узлом
+     * (несколько "узлов" с одними и теми же процессорами)
+     */
+    static NumaTopology from_nodes(std::vector<NumaNode> nodes) {
+        if (nodes.empty()) {
+            return single_node();
+        }
+        NumaTopology topology;
+        topology.nodes_ = std::move(nodes);
+        return topology;
+    }
+
+    const std::vector<NumaNode>& nodes() const {
+        return nodes_;
+    }
+
+    std::size_t node_count() const {
+        return nodes_.size();
+    }
+
+    /**
+     * Больше одного узла - имеет смысл привязывать потоки и разбивать работу по узлам
+     */
+    bool is_numa() const {
+        return nodes_.size() > 1;
+    }
+
+private:
+    NumaTopology() = default;
+
+private:
+    std::vector<NumaNode> nodes_;
+};
@@ -1,6 +1,8 @@
 #pragma once
 
 #include "base_solver.hpp"
+#include "block_max_summary.hpp"
+#include "chunking.hpp"
 
 #include <cassert>
 #include <future>
@@ -25,6 +27,9 @@
  *   - каждый поток возвращает локальный минимальный индекс через FutureResult, либо же проставляет флажок exited_early,
  *         сигнализирующий о том, что поток завершился досрочно, так как дальше не имеет смысла его выполнять
  *   - зная индекс - получаем сам элемент (если такой существует)
+ *   - если подключена сводка максимумов по блокам (attach_summary), то поток ищет в своей части через сводку:
+ *         блоки с максимумом <= порога перепрыгиваются целиком, не читая их элементов и не трогая мьютекс;
+ *         мьютекс берётся только перед поиском (проверка досрочного завершения) и при публикации результата
  */
 template<typename T>
 class ParallelSolver : public BaseSolver<T> {
@@ -32,8 +37,10 @@ public:
     /**
      * Конструктор
      * @param num_threads количество потоков (опционально, если не указано - используется значение hardware_concurrency)
+     * @param report_early_exit печатать ли в std::cerr, какие потоки завершились досрочно (бенчмарк это отключает)
      */
-    explicit ParallelSolver(std::optional<int> num_threads = std::nullopt) {
+    explicit ParallelSolver(std::optional<int> num_threads = std::nullopt, bool report_early_exit = true)
+        : report_early_exit_(report_early_exit) {
         if (num_threads.has_value()) {
             num_threads_ = num_threads.value();
         } else {
@@ -58,42 +65,35 @@ private:
     };
 
 public:
-    std::optional<T> solve(const std::vector<T>& arr, T threshold) override {
+    std::optional<T> solve(std::span<const T> arr, T threshold) override {
         if (arr.empty()) {
             return std::nullopt;
         }
         
         int actual_threads = std::min(num_threads_, static_cast<int>(arr.size()));
+
+        // Сбрасываем результат предыдущего вызова (иначе повторный solve увидел бы старый индекс)
+        global_min_index_ = std::nullopt;
         
         std::vector<std::thread> threads;
         std::vector<std::future<FutureResult>> futures;
         threads.reserve(actual_threads);
         futures.reserve(actual_threads);
         
-        // Размер части для каждого потока
-        std::size_t chunk_size = arr.size() / actual_threads;
-        std::size_t remainder = arr.size() % actual_threads;
-        
-        std::size_t current_start = 0;
-        // Создаём и запускаем потоки
-        for (int i = 0; i < actual_threads; i++) {
-            std::size_t current_chunk_size = chunk_size + (i < static_cast<int>(remainder) ? 1 : 0);
-            std::size_t current_end = current_start + current_chunk_size;
-            
+        // Создаём и запускаем потоки, по одному на часть массива
+        for (const ChunkRange& chunk : split_into_chunks(arr.size(), actual_threads)) {
             std::promise<FutureResult> promise;
             futures.push_back(promise.get_future());
             
             threads.emplace_back(
                 &ParallelSolver::worker_thread,
                 this,
-                std::cref(arr),
+                arr,
                 threshold,
-                current_start,
-                current_end,
+                chunk.begin,
+                chunk.end,
                 std::move(promise)
             );
-            
-            current_start = current_end;
         }
         
         // Ждём завершения всех потоков
@@ -111,7 +111,7 @@ public:
         // Так что полученное решение - чисто для демонстрации совместного использования фьючей/промисов и мьютекса
         for (size_t i = 0; i < futures.size(); i++) {
             auto result = futures[i].get();
-            if (result.exited_early) {
+            if (result.exited_early && report_early_exit_) {
                 std::cerr << "Поток " << i << " завершился досрочно" << std::endl;
             }
         }
@@ -128,6 +128,15 @@ public:
         return "Параллельная версия (std::thread, " + std::to_string(num_threads_) + " потоков)";
     }
 
+    /**
+     * Подключить сводку максимумов по блокам (не владеющий указатель, nullptr - отключить)
+     * Контракт: сводка построена по тому же массиву, что передаётся в solve, и поддерживается через
+     * BlockMaxSummary::update (или build) при каждом его изменении - иначе блоки с совпадениями будут пропущены
+     */
+    void attach_summary(const BlockMaxSummary<T>* summary) {
+        summary_ = summary;
+    }
+
 private:
     /**
      * Функция, выполняемая каждым потоком
@@ -139,7 +148,7 @@ private:
      * @param result_promise promise для возврата локального минимального индекса
      */
     void worker_thread(
-        const std::vector<T>& arr,
+        std::span<const T> arr,
         T threshold,
         std::size_t start_idx,
         std::size_t end_idx,
@@ -148,19 +157,35 @@ private:
         std::optional<std::size_t> local_min_index = std::nullopt;
         bool exited_early = false;
         
-        // Поиск минимального индекса в своей части массива
-        for (std::size_t i = start_idx; i < end_idx; i++) {
-            // Если другой поток уже нашёл элемент с меньшим индексом, то завершаем свою работу досрочно
+        if (summary_ != nullptr) {
+            assert(summary_->size() == arr.size());
+            // Со сводкой поэлементный цикл под мьютексом не нужен: блоки пропускаются векторным проходом по сводке,
+            // поэтому досрочное завершение проверяется один раз - до поиска
             {
                 std::lock_guard<std::mutex> lock(mutex_);
-                if (global_min_index_.has_value() && global_min_index_.value() < i) {
-                    exited_early = true;
-                    break;
+                exited_early = global_min_index_.has_value() && global_min_index_.value() < start_idx;
+            }
+            if (!exited_early) {
+                std::size_t index = summary_->find_first_greater(arr.data(), start_idx, end_idx, threshold);
+                if (index != end_idx) {
+                    local_min_index = index;
                 }
             }
-            if (arr[i] > threshold) {
-                local_min_index = i;
-                break; // Нашли первый элемент в своей части - можно выходить
+        } else {
+            // Поиск минимального индекса в своей части массива
+            for (std::size_t i = start_idx; i < end_idx; i++) {
+                // Если другой поток уже нашёл элемент с меньшим индексом, то завершаем свою работу досрочно
+                {
+                    std::lock_guard<std::mutex> lock(mutex_);
+                    if (global_min_index_.has_value() && global_min_index_.value() < i) {
+                        exited_early = true;
+                        break;
+                    }
+                }
+                if (arr[i] > threshold) {
+                    local_min_index = i;
+                    break; // Нашли первый элемент в своей части - можно выходить
+                }
             }
         }
 
@@ -191,7 +216,9 @@ private:
 
 private:
     int num_threads_;
+    bool report_early_exit_;
     std::mutex mutex_ = {};
     std::optional<std::size_t> global_min_index_ = std::nullopt;
+    const BlockMaxSummary<T>* summary_ = nullptr;
 };
 
@@ -0,0 +1,206 @@
+#pragma once
+
+#include "base_solver.hpp"
+#include "chunking.hpp"
+#include "simd_search.hpp"
+#include "thread_pool.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <future>
+#include <limits>
+#include <memory>
+#include <thread>
+#include <optional>
+#include <vector>
+
+
+/**
+ * Параллельная реализация задачи поверх постоянного пула потоков
+ * Рассчитана на частые вызовы solve на массивах среднего размера,
+ * когда создание и join потоков на каждый вызов стоит дороже самого поиска
+ *
+ * Суть:
+ *   - потоки создаются один раз в конструкторе (ThreadPool) и между вызовами solve ждут задач
+ *   - на каждый вызов массив делится на части по числу потоков пула, каждая часть - отдельная задача
+ *   - результат каждой задачи возвращается через свой promise/future, созданный на этот вызов
+ *   - досрочный выход - как в AtomicParallelSolver: общий std::atomic<size_t> с CAS-min,
+ *     проверяемый relaxed-загрузкой раз в блок
+ */
+template<typename T>
+class PoolParallelSolver : public BaseSolver<T> {
+public:
+    /**
+     * Конструктор
+     * @param num_threads количество потоков пула (опционально, если не указано - используется значение hardware_concurrency)
+     * @param block_size сколько элементов просматривается между проверками глобального индекса
+     */
+    explicit PoolParallelSolver(std::optional<int> num_threads = std::nullopt, std::size_t block_size = 4096)
+        : block_size_(std::max<std::size_t>(block_size, 1)) {
+        std::size_t pool_size = 0;
+        if (num_threads.has_value()) {
+            pool_size = static_cast<std::size_t>(std::max(num_threads.value(), 1));
+        } else {
+            auto hc = std::thread::hardware_concurrency();
+            pool_size = (hc == 0) ? 2 : hc; // fallback на случай, если hardware_concurrency не работает
+        }
+        pool_ = std::make_unique<ThreadPool>(pool_size);
+    }
+
+private:
+    // Значение global_min_index_, означающее "ничего не найдено"
+    static constexpr std::size_t kNotFound = std::numeric_limits<std::size_t>::max();
+
+public:
+    std::optional<T> solve(std::span<const T> arr, T threshold) override {
+        std::size_t index = first_index(arr, threshold, pool_->size());
+
+        // Элемент, больший порога, не найден
+        if (index == arr.size()) {
+            return std::nullopt;
+        }
+
+        return arr[index];
+    }
+
+    /**
+     * Индекс первого элемента больше порога, или arr.size(), если такого нет
+     * В отличие от solve, число задач (частей массива) задаётся явно - не больше размера пула
+     *
+     * @param arr массив чисел для поиска
+     * @param threshold пороговое значение
+     * @param num_tasks на сколько частей делить массив
+     */
+    std::size_t first_index(std::span<const T> arr, T threshold, std::size_t num_tasks) {
+        if (arr.empty()) {
+            return 0;
+        }
+
+        num_tasks = std::clamp<std::size_t>(num_tasks, 1, std::min(pool_->size(), arr.size()));
+
+        // Сбрасываем результат предыдущего вызова
+        global_min_index_.store(kNotFound, std::memory_order_relaxed);
+
+        std::vector<std::future<std::size_t>> futures;
+        futures.reserve(num_tasks);
+
+        for (const ChunkRange& chunk : split_into_chunks(arr.size(), num_tasks)) {
+            // std::function требует копируемый callable, поэтому promise передаём через shared_ptr
+            auto promise = std::make_shared<std::promise<std::size_t>>();
+            futures.push_back(promise->get_future());
+
+            const T* data = arr.data();
+            pool_->submit([this, data, threshold, chunk, promise] {
+                promise->set_value(scan_range(data, threshold, chunk.begin, chunk.end));
+            });
+        }
+
+        // Редукция по минимуму из локальных индексов
+        std::size_t min_index = kNotFound;
+        for (auto& future : futures) {
+            min_index = std::min(min_index, future.get());
+        }
+
+        return min_index == kNotFound ? arr.size() : min_index;
+    }
+
+    /**
+     * Несколько порогов за один параллельный проход
+     * Каждая задача пула гасит пороги в своей части (scan_many), результаты сливаются слева направо (merge_many)
+     */
+    std::vector<std::optional<T>> solve_many(std::span<const T> arr, std::span<const T> thresholds) override {
+        SortedThresholds<T> sorted = sort_thresholds(thresholds);
+        if (arr.empty() || sorted.values.empty()) {
+            return std::vector<std::optional<T>>(thresholds.size(), std::nullopt);
+        }
+
+        std::size_t num_tasks = std::min(pool_->size(), arr.size());
+
+        std::vector<std::future<std::vector<std::size_t>>> futures;
+        futures.reserve(num_tasks);
+
+        for (const ChunkRange& chunk : split_into_chunks(arr.size(), num_tasks)) {
+            auto promise = std::make_shared<std::promise<std::vector<std::size_t>>>();
+            futures.push_back(promise->get_future());
+
+            const T* data = arr.data();
+            const std::vector<T>* values = &sorted.values;
+            pool_->submit([data, values, chunk, promise] {
+                promise->set_value(scan_many(data, chunk.begin, chunk.end, *values));
+            });
+        }
+
+        std::vector<std::vector<std::size_t>> chunk_results;
+        chunk_results.reserve(num_tasks);
+        for (auto& future : futures) {
+            chunk_results.push_back(future.get());
+        }
+
+        return merge_many(arr.data(), sorted, chunk_results);
+    }
+
+    std::string get_name() const override {
+        return "Параллельная версия (пул потоков, " + std::to_string(pool_->size()) + " потоков)";
+    }
+
+    /**
+     * Количество потоков в пуле
+     */
+    std::size_t pool_size() const {
+        return pool_->size();
+    }
+
+    /**
+     * Количество задач, ожидающих в очереди пула
+     */
+    std::size_t queue_depth() const {
+        return pool_->queue_depth();
+    }
+
+    /**
+     * Общее количество задач, выполненных пулом
+     */
+    std::size_t completed_tasks() const {
+        return pool_->completed_tasks();
+    }
+
+private:
+    /**
+     * Поиск первого элемента, большего порога, в диапазоне [start_idx, end_idx)
+     * @return индекс найденного элемента или kNotFound (в том числе при досрочном выходе)
+     */
+    std::size_t scan_range(const T* data, T threshold, std::size_t start_idx, std::size_t end_idx) {
+        for (std::size_t block_start = start_idx; block_start < end_idx; block_start += block_size_) {
+            // Другая задача уже нашла элемент левее - дальше искать бессмысленно
+            if (global_min_index_.load(std::memory_order_relaxed) < block_start) {
+                return kNotFound;
+            }
+
+            std::size_t block_end = std::min(block_start + block_size_, end_idx);
+            std::size_t block_len = block_end - block_start;
+            std::size_t offset = find_first_greater(data + block_start, block_len, threshold);
+            if (offset != block_len) {
+                publish_min_index(block_start + offset);
+                return block_start + offset;
+            }
+        }
+        return kNotFound;
+    }
+
+    /**
+     * Атомарно заменить global_min_index_ на index, если index меньше текущего значения (CAS-min)
+     */
+    void publish_min_index(std::size_t index) {
+        std::size_t current = global_min_index_.load(std::memory_order_relaxed);
+        while (index < current &&
+               !global_min_index_.compare_exchange_weak(current, index, std::memory_order_relaxed)) {
+            // current обновлён compare_exchange_weak - пробуем снова
+        }
+    }
+
+private:
+    std::size_t block_size_;
+    std::atomic<std::size_t> global_min_index_ = kNotFound;
+    // Пул объявлен последним: разрушается первым и дожидается задач, которые обращаются к полям выше
+    std::unique_ptr<ThreadPool> pool_;
+};
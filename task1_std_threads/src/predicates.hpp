@@ -0,0 +1,285 @@
+#pragma once
+
+#include "cpu_features.hpp"
+#include "simd_search.hpp"
+
+#include <cstddef>
+#include <type_traits>
+
+/**
+ * Предикаты поиска: "первый элемент, для которого pred(x) истинно"
+ *
+ * Каждый предикат - отдельный тип (политика), который подставляется в шаблон ядра find_first_if
+ * во время компиляции. Поэтому для каждого предиката собирается своё ядро без косвенных вызовов
+ * (std::function, виртуальные функции) на каждый элемент.
+ *
+ * У политики есть:
+ *   - operator()(x) - скалярная проверка без ветвлений (для диапазона - & вместо &&)
+ *   - для long long на x86 - avx512_mask(v): маска по 8 элементам за одно сравнение _mm512_cmp_epi64_mask,
+ *     и avx2_mask(v): 4-битная маска по 4 элементам (в AVX2 есть только > и ==, остальное выражается через них)
+ */
+
+#if defined(SIMD_SEARCH_X86)
+#define PREDICATE_AVX512 __attribute__((target("avx512f")))
+#define PREDICATE_AVX2 __attribute__((target("avx2")))
+
+namespace predicate_detail {
+
+// 4-битная маска по старшим битам 64-битных элементов
+PREDICATE_AVX2 inline unsigned movemask64(__m256i v) {
+    return static_cast<unsigned>(_mm256_movemask_pd(_mm256_castsi256_pd(v)));
+}
+
+} // namespace predicate_detail
+#endif
+
+/**
+ * x > threshold - исходное условие задачи
+ */
+template<typename T>
+struct Greater {
+    T threshold;
+
+    bool operator()(T x) const {
+        return x > threshold;
+    }
+
+#if defined(SIMD_SEARCH_X86)
+    PREDICATE_AVX512 __mmask8 avx512_mask(__m512i v) const {
+        return _mm512_cmp_epi64_mask(v, _mm512_set1_epi64(threshold), _MM_CMPINT_NLE);
+    }
+
+    PREDICATE_AVX2 unsigned avx2_mask(__m256i v) const {
+        return predicate_detail::movemask64(_mm256_cmpgt_epi64(v, _mm256_set1_epi64x(threshold)));
+    }
+#endif
+};
+
+/**
+ * x >= threshold
+ */
+template<typename T>
+struct GreaterEqual {
+    T threshold;
+
+    bool operator()(T x) const {
+        return x >= threshold;
+    }
+
+#if defined(SIMD_SEARCH_X86)
+    PREDICATE_AVX512 __mmask8 avx512_mask(__m512i v) const {
+        return _mm512_cmp_epi64_mask(v, _mm512_set1_epi64(threshold), _MM_CMPINT_NLT);
+    }
+
+    PREDICATE_AVX2 unsigned avx2_mask(__m256i v) const {
+        // x >= t  <=>  !(t > x)
+        return predicate_detail::movemask64(_mm256_cmpgt_epi64(_mm256_set1_epi64x(threshold), v)) ^ 0xFu;
+    }
+#endif
+};
+
+/**
+ * x < threshold
+ */
+template<typename T>
+struct Less {
+    T threshold;
+
+    bool operator()(T x) const {
+        return x < threshold;
+    }
+
+#if defined(SIMD_SEARCH_X86)
+    PREDICATE_AVX512 __mmask8 avx512_mask(__m512i v) const {
+        return _mm512_cmp_epi64_mask(v, _mm512_set1_epi64(threshold), _MM_CMPINT_LT);
+    }
+
+    PREDICATE_AVX2 unsigned avx2_mask(__m256i v) const {
+        return predicate_detail::movemask64(_mm256_cmpgt_epi64(_mm256_set1_epi64x(threshold), v));
+    }
+#endif
+};
+
+/**
+ * x == value
+ */
+template<typename T>
+struct Equal {
+    T value;
+
+    bool operator()(T x) const {
+        return x == value;
+    }
+
+#if defined(SIMD_SEARCH_X86)
+    PREDICATE_AVX512 __mmask8 avx512_mask(__m512i v) const {
+        return _mm512_cmp_epi64_mask(v, _mm512_set1_epi64(value), _MM_CMPINT_EQ);
+    }
+
+    PREDICATE_AVX2 unsigned avx2_mask(__m256i v) const {
+        return predicate_detail::movemask64(_mm256_cmpeq_epi64(v, _mm256_set1_epi64x(value)));
+    }
+#endif
+};
+
+/**
+ * x != value
+ */
+template<typename T>
+struct NotEqual {
+    T value;
+
+    bool operator()(T x) const {
+        return x != value;
+    }
+
+#if defined(SIMD_SEARCH_X86)
+    PREDICATE_AVX512 __mmask8 avx512_mask(__m512i v) const {
+        return _mm512_cmp_epi64_mask(v, _mm512_set1_epi64(value), _MM_CMPINT_NE);
+    }
+
+    PREDICATE_AVX2 unsigned avx2_mask(__m256i v) const {
+        return predicate_detail::movemask64(_mm256_cmpeq_epi64(v, _mm256_set1_epi64x(value))) ^ 0xFu;
+    }
+#endif
+};
+
+/**
+ * lo <= x < hi
+ */
+template<typename T>
+struct InRange {
+    T lo;
+    T hi;
+
+    bool operator()(T x) const {
+        return (x >= lo) & (x < hi);
+    }
+
+#if defined(SIMD_SEARCH_X86)
+    PREDICATE_AVX512 __mmask8 avx512_mask(__m512i v) const {
+        __mmask8 above_lo = _mm512_cmp_epi64_mask(v, _mm512_set1_epi64(lo), _MM_CMPINT_NLT);
+        // Вторая проверка - только по элементам, прошедшим первую
+        return _mm512_mask_cmp_epi64_mask(above_lo, v, _mm512_set1_epi64(hi), _MM_CMPINT_LT);
+    }
+
+    PREDICATE_AVX2 unsigned avx2_mask(__m256i v) const {
+        // lo <= x  <=>  !(lo > x)
+        __m256i below_lo = _mm256_cmpgt_epi64(_mm256_set1_epi64x(lo), v);
+        __m256i below_hi = _mm256_cmpgt_epi64(_mm256_set1_epi64x(hi), v);
+        return predicate_detail::movemask64(_mm256_andnot_si256(below_lo, below_hi));
+    }
+#endif
+};
+
+namespace predicate_detail {
+
+// Сколько элементов проверяется без ветвлений перед проверкой "нашлось ли что-нибудь"
+inline constexpr std::size_t kBlock = 16;
+
+/**
+ * Переносимое ядро: в блоке из kBlock элементов результаты предиката объединяются через |
+ * без ветвлений (такой цикл с известным числом итераций компилятор векторизует),
+ * точная позиция ищется, только если в блоке что-то нашлось
+ */
+template<typename T, typename Pred>
+std::size_t find_first_if_portable(const T* data, std::size_t n, const Pred& pred) {
+    std::size_t i = 0;
+    for (; i + kBlock <= n; i += kBlock) {
+        bool any = false;
+        for (std::size_t j = 0; j < kBlock; j++) {
+            any |= pred(data[i + j]);
+        }
+        if (any) {
+            break;
+        }
+    }
+    for (; i < n; i++) {
+        if (pred(data[i])) {
+            return i;
+        }
+    }
+    return n;
+}
+
+#if defined(SIMD_SEARCH_X86)
+
+/**
+ * AVX-512: 16 элементов (две кэш-линии) за итерацию, маски двух сравнений объединяются,
+ * позиция - через __builtin_ctz, как в find_first_greater_avx512
+ */
+template<typename Pred>
+PREDICATE_AVX512 std::size_t find_first_if_avx512(const long long* data, std::size_t n, const Pred& pred) {
+    std::size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        __mmask8 m0 = pred.avx512_mask(_mm512_loadu_si512(data + i));
+        __mmask8 m1 = pred.avx512_mask(_mm512_loadu_si512(data + i + 8));
+        unsigned mask = static_cast<unsigned>(m0) | (static_cast<unsigned>(m1) << 8);
+        if (mask != 0) {
+            return i + __builtin_ctz(mask);
+        }
+    }
+    for (; i < n; i++) {
+        if (pred(data[i])) {
+            return i;
+        }
+    }
+    return n;
+}
+
+/**
+ * AVX2: 16 элементов (четыре вектора по 4) за итерацию, 4-битные маски склеиваются в одну
+ */
+template<typename Pred>
+PREDICATE_AVX2 std::size_t find_first_if_avx2(const long long* data, std::size_t n, const Pred& pred) {
+    std::size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        unsigned mask = pred.avx2_mask(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i)))
+                      | pred.avx2_mask(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i + 4))) << 4
+                      | pred.avx2_mask(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i + 8))) << 8
+                      | pred.avx2_mask(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i + 12))) << 12;
+        if (mask != 0) {
+            return i + __builtin_ctz(mask);
+        }
+    }
+    for (; i < n; i++) {
+        if (pred(data[i])) {
+            return i;
+        }
+    }
+    return n;
+}
+
+#endif // SIMD_SEARCH_X86
+
+} // namespace predicate_detail
+
+/**
+ * Индекс первого элемента data[0..n), для которого pred истинно, или n, если такого нет
+ *
+ * Для Greater<long long> используется find_first_greater (вариант по CPUID: SSE4.2, AVX2 или AVX-512);
+ * для остальных предикатов над long long - AVX-512 или AVX2, если процессор их поддерживает;
+ * иначе (и для произвольных callable без avx512_mask) - переносимое блочное ядро
+ */
+template<typename T, typename Pred>
+std::size_t find_first_if(const T* data, std::size_t n, const Pred& pred) {
+    if constexpr (std::is_same_v<T, long long>) {
+        if constexpr (std::is_same_v<Pred, Greater<long long>>) {
+            return find_first_greater(data, n, pred.threshold);
+        }
+#if defined(SIMD_SEARCH_X86)
+        // Любой callable подходит как предикат; векторные ядра - только если у него есть avx512_mask / avx2_mask
+        if constexpr (requires(const Pred& p, __m512i v) { p.avx512_mask(v); }) {
+            if (cpu_features().avx512f) {
+                return predicate_detail::find_first_if_avx512(data, n, pred);
+            }
+        }
+        if constexpr (requires(const Pred& p, __m256i v) { p.avx2_mask(v); }) {
+            if (cpu_features().avx2) {
+                return predicate_detail::find_first_if_avx2(data, n, pred);
+            }
+        }
+#endif
+    }
+    return predicate_detail::find_first_if_portable(data, n, pred);
+}
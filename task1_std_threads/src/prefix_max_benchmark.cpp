@@ -0,0 +1,114 @@
+#include "prefix_max_solver.hpp"
+#include "simd_solver.hpp"
+
+#include <cstdlib>
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <optional>
+#include <random>
+#include <vector>
+
+/**
+ * Бенчмарк индекса префиксных максимумов: сколько стоит построение
+ * и после какого числа запросов оно окупается по сравнению с линейным SIMD-поиском
+ *
+ * Пороги берутся из верхней части диапазона значений, чтобы первое совпадение было далеко от начала массива
+ * (иначе линейный поиск заканчивается на первых элементах и сравнивать нечего)
+ */
+
+void print_usage(const char* prog_name) {
+    std::cout << "Использование: " << prog_name << " [размер_массива] [количество_запросов] [количество_потоков]" << std::endl;
+}
+
+int main(int argc, char* argv[]) {
+    std::size_t array_size = 10000000;
+    std::size_t num_queries = 1000;
+    std::optional<int> num_threads = std::nullopt;
+
+    if (argc > 4) {
+        std::cerr << "Ошибка: слишком много аргументов" << std::endl;
+        print_usage(argv[0]);
+        return 1;
+    }
+    if (argc >= 2 && (std::string(argv[1]) == "-h" || std::string(argv[1]) == "--help")) {
+        print_usage(argv[0]);
+        return 0;
+    }
+    if (argc >= 2) {
+        array_size = std::strtoull(argv[1], nullptr, 10);
+    }
+    if (argc >= 3) {
+        num_queries = std::strtoull(argv[2], nullptr, 10);
+    }
+    if (argc >= 4) {
+        num_threads = std::atoi(argv[3]);
+    }
+    if (array_size == 0 || num_queries == 0) {
+        std::cerr << "Ошибка: размер массива и количество запросов должны быть положительными" << std::endl;
+        return 1;
+    }
+
+    // Значения в [0, value_range): префиксный максимум растёт постепенно по всему массиву
+    const long long value_range = 1000000000000LL;
+    std::vector<long long> arr(array_size);
+    std::mt19937_64 gen(42);
+    std::uniform_int_distribution<long long> value_distr(0, value_range - 1);
+    std::generate(arr.begin(), arr.end(), [&]() { return value_distr(gen); });
+
+    // Пороги - в верхней миллионной доле диапазона (в том числе такие, для которых ответа нет)
+    std::vector<long long> thresholds(num_queries);
+    std::uniform_int_distribution<long long> threshold_distr(value_range - value_range / 1000000, value_range);
+    std::generate(thresholds.begin(), thresholds.end(), [&]() { return threshold_distr(gen); });
+
+    using clock = std::chrono::steady_clock;
+    auto micros = [](clock::duration d) {
+        return std::chrono::duration<double, std::micro>(d).count();
+    };
+
+    // Линейный поиск
+    SimdSolver linear;
+    long long checksum_linear = 0;
+    auto start = clock::now();
+    for (long long t : thresholds) {
+        checksum_linear += linear.solve(arr, t).value_or(-1);
+    }
+    double linear_total = micros(clock::now() - start);
+
+    // Построение индекса
+    PrefixMaxSolver<long long> indexed(num_threads);
+    start = clock::now();
+    indexed.build(arr);
+    double build_time = micros(clock::now() - start);
+
+    // Запросы к индексу
+    long long checksum_indexed = 0;
+    start = clock::now();
+    for (long long t : thresholds) {
+        checksum_indexed += indexed.query(t).value_or(-1);
+    }
+    double indexed_total = micros(clock::now() - start);
+
+    double linear_per_query = linear_total / num_queries;
+    double indexed_per_query = indexed_total / num_queries;
+
+    std::cout << "Размер массива:          " << array_size << std::endl;
+    std::cout << "Количество запросов:     " << num_queries << std::endl;
+    std::cout << "Реализация индекса:      " << indexed.get_name() << std::endl;
+    std::cout << "========================================" << std::endl;
+    std::cout << "Линейный поиск (" << simd_kernel_name() << "): " << linear_per_query << " мкс на запрос" << std::endl;
+    std::cout << "Построение индекса:      " << build_time << " мкс" << std::endl;
+    std::cout << "Запрос к индексу:        " << indexed_per_query << " мкс на запрос" << std::endl;
+    if (linear_per_query > indexed_per_query) {
+        std::cout << "Индекс окупается после   " << build_time / (linear_per_query - indexed_per_query) << " запросов" << std::endl;
+    } else {
+        std::cout << "Индекс не окупается на этих запросах" << std::endl;
+    }
+
+    if (checksum_linear != checksum_indexed) {
+        std::cerr << "Ошибка: результаты линейного поиска и индекса не совпадают" << std::endl;
+        return 1;
+    }
+    return 0;
+}
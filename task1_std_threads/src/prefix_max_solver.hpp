@@ -0,0 +1,148 @@
+#pragma once
+
+#include "base_solver.hpp"
+
+#include <algorithm>
+#include <thread>
+#include <optional>
+#include <vector>
+
+
+/**
+ * Решение задачи через индекс префиксных максимумов - для статических массивов, по которым много запросов
+ *
+ * Суть:
+ *   - первый индекс i с arr[i] > t совпадает с первым индексом, где префиксный максимум
+ *     prefix_max[i] = max(arr[0..i]) превышает t
+ *   - prefix_max не убывает, поэтому этот индекс ищется бинарным поиском (std::upper_bound) за O(log n)
+ *   - в найденной позиции prefix_max[i] == arr[i] (максимум вырос именно на этом элементе),
+ *     так что для ответа сам массив уже не нужен
+ *
+ * Фазы:
+ *   - build(arr) - параллельное построение за O(n) (std::thread):
+ *       1) каждый поток считает префиксные максимумы своей части и её максимум
+ *       2) последовательно считаются максимумы всех частей левее каждой части
+ *       3) каждый поток "поднимает" свою часть до максимума частей левее
+ *   - query(threshold) - запрос к построенному индексу за O(log n)
+ *   - solve(arr, threshold) / solve_many - без состояния между вызовами: каждый вызов строит индекс заново
+ *     (массив мог измениться по тому же адресу), так что окупается только solve_many с многими порогами
+ *
+ * Индекс переиспользуется только явно: build(arr) один раз, затем query сколько угодно.
+ * Индекс не отслеживает изменения массива: после изменения элементов нужно заново вызвать build
+ */
+template<typename T>
+class PrefixMaxSolver : public BaseSolver<T> {
+public:
+    /**
+     * Конструктор
+     * @param num_threads количество потоков для построения (опционально, если не указано - используется значение hardware_concurrency)
+     */
+    explicit PrefixMaxSolver(std::optional<int> num_threads = std::nullopt) {
+        if (num_threads.has_value()) {
+            num_threads_ = std::max(num_threads.value(), 1);
+        } else {
+            auto hc = std::thread::hardware_concurrency();
+            if (hc == 0) {
+                num_threads_ = 2; // fallback на случай, если hardware_concurrency не работает
+            } else {
+                num_threads_ = hc;
+            }
+        }
+    }
+
+    /**
+     * Построить индекс префиксных максимумов для массива
+     */
+    void build(std::span<const T> arr) {
+        prefix_max_.resize(arr.size());
+        if (arr.empty()) {
+            return;
+        }
+
+        int actual_threads = std::min(num_threads_, static_cast<int>(arr.size()));
+        std::vector<std::size_t> bounds(actual_threads + 1);
+        for (int i = 0; i <= actual_threads; i++) {
+            bounds[i] = arr.size() * i / actual_threads;
+        }
+
+        // 1) Локальные префиксные максимумы каждой части
+        run_parallel(actual_threads, [&](int part) {
+            T running = arr[bounds[part]];
+            for (std::size_t i = bounds[part]; i < bounds[part + 1]; i++) {
+                running = std::max(running, arr[i]);
+                prefix_max_[i] = running;
+            }
+        });
+
+        // 2) Максимум всех частей левее: последний элемент части - её максимум
+        std::vector<T> carry(actual_threads);
+        for (int part = 1; part < actual_threads; part++) {
+            T left = prefix_max_[bounds[part] - 1];
+            carry[part] = (part == 1) ? left : std::max(carry[part - 1], left);
+        }
+
+        // 3) Поднимаем каждую часть (кроме первой) до максимума частей левее
+        run_parallel(actual_threads, [&](int part) {
+            if (part == 0) {
+                return;
+            }
+            for (std::size_t i = bounds[part]; i < bounds[part + 1]; i++) {
+                prefix_max_[i] = std::max(prefix_max_[i], carry[part]);
+            }
+        });
+    }
+
+    std::optional<T> solve(std::span<const T> arr, T threshold) override {
+        build(arr);
+        return query(threshold);
+    }
+
+    /**
+     * Несколько порогов - одно построение индекса и по бинарному поиску на каждый порог
+     */
+    std::vector<std::optional<T>> solve_many(std::span<const T> arr, std::span<const T> thresholds) override {
+        build(arr);
+        std::vector<std::optional<T>> answers;
+        answers.reserve(thresholds.size());
+        for (T threshold : thresholds) {
+            answers.push_back(query(threshold));
+        }
+        return answers;
+    }
+
+    /**
+     * Запрос к уже построенному индексу за O(log n)
+     * @return std::nullopt, если число не найдено; иначе первое число, превышающее threshold
+     */
+    std::optional<T> query(T threshold) const {
+        auto it = std::upper_bound(prefix_max_.begin(), prefix_max_.end(), threshold);
+        if (it == prefix_max_.end()) {
+            return std::nullopt;
+        }
+        return *it;
+    }
+
+    std::string get_name() const override {
+        return "Индекс префиксных максимумов (построение в " + std::to_string(num_threads_) + " потоков)";
+    }
+
+private:
+    /**
+     * Выполнить func(part) для part = 0..num_parts-1 в отдельных потоках и дождаться завершения
+     */
+    template<typename Func>
+    static void run_parallel(int num_parts, Func func) {
+        std::vector<std::thread> threads;
+        threads.reserve(num_parts);
+        for (int part = 0; part < num_parts; part++) {
+            threads.emplace_back(func, part);
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+    }
+
+private:
+    int num_threads_;
+    std::vector<T> prefix_max_;
+};
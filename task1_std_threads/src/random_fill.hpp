@@ -0,0 +1,103 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <span>
+#include <thread>
+#include <vector>
+
+
+/**
+ * Параллельная генерация случайного массива на счётчиковом генераторе (SplitMix64)
+ *
+ * Суть:
+ *   - значение элемента i зависит только от seed и i: value(i) = mix(key + (i + 1) * gamma),
+ *     где key = mix(seed + gamma) - первый выход SplitMix64, засеянного seed. Значит, value(i) - ровно i-й выход
+ *     (с нуля) последовательного SplitMix64, засеянного key
+ *   - поэтому любой диапазон индексов можно заполнить независимо от остальных,
+ *     и результат детерминирован для заданного seed и не зависит от числа потоков
+ *   - память выделяется без инициализации, и каждый поток первым пишет в свою часть
+ *     (first touch): страницы оказываются на том узле NUMA, где работает поток,
+ *     который при статическом разбиении будет эту часть и просматривать
+ */
+
+namespace random_fill_detail {
+
+inline constexpr std::uint64_t kGamma = 0x9e3779b97f4a7c15ULL;
+
+inline std::uint64_t mix(std::uint64_t z) {
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+    return z ^ (z >> 31);
+}
+
+} // namespace random_fill_detail
+
+/**
+ * Случайное 64-битное значение для позиции index при заданном seed
+ */
+inline std::uint64_t counter_random(std::uint64_t seed, std::uint64_t index) {
+    using namespace random_fill_detail;
+    std::uint64_t key = mix(seed + kGamma);
+    return mix(key + (index + 1) * kGamma);
+}
+
+/**
+ * Заполнить массив параллельно значениями out[i] = value_at(i): каждый поток пишет свою непрерывную часть
+ * value_at должна зависеть только от i - тогда результат не зависит от числа потоков
+ *
+ * @param out массив для заполнения
+ * @param value_at функция индекс -> значение
+ * @param num_threads количество потоков (опционально, если не указано - используется значение hardware_concurrency)
+ */
+template<typename T, typename ValueAt>
+void fill_parallel(std::span<T> out, ValueAt value_at, std::optional<int> num_threads = std::nullopt) {
+    int threads_count = 0;
+    if (num_threads.has_value()) {
+        threads_count = std::max(num_threads.value(), 1);
+    } else {
+        auto hc = std::thread::hardware_concurrency();
+        threads_count = (hc == 0) ? 2 : static_cast<int>(hc); // fallback на случай, если hardware_concurrency не работает
+    }
+    threads_count = static_cast<int>(std::min<std::size_t>(threads_count, std::max<std::size_t>(out.size(), 1)));
+
+    std::vector<std::thread> threads;
+    threads.reserve(threads_count);
+    for (int part = 0; part < threads_count; part++) {
+        std::size_t begin = out.size() * part / threads_count;
+        std::size_t end = out.size() * (part + 1) / threads_count;
+        threads.emplace_back([out, &value_at, begin, end] {
+            for (std::size_t i = begin; i < end; i++) {
+                out[i] = value_at(i);
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+}
+
+/**
+ * Заполнить весь массив случайными значениями параллельно
+ *
+ * @param out массив для заполнения
+ * @param seed зерно генератора
+ * @param num_threads количество потоков (опционально, если не указано - используется значение hardware_concurrency)
+ */
+template<typename T>
+void fill_random(std::span<T> out, std::uint64_t seed, std::optional<int> num_threads = std::nullopt) {
+    fill_parallel(out, [seed](std::size_t i) { return static_cast<T>(counter_random(seed, i)); }, num_threads);
+}
+
+/**
+ * Выделить массив из size элементов без инициализации и заполнить его параллельно (с first touch)
+ * В отличие от std::vector<T>(size), память не обнуляется одним потоком заранее
+ */
+template<typename T>
+std::unique_ptr<T[]> make_random_array(std::size_t size, std::uint64_t seed, std::optional<int> num_threads = std::nullopt) {
+    std::unique_ptr<T[]> data = std::make_unique_for_overwrite<T[]>(size);
+    fill_random(std::span<T>(data.get(), size), seed, num_threads);
+    return data;
+}
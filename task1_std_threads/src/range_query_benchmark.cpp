@@ -0,0 +1,142 @@
+#include "range_query_solver.hpp"
+
+#include <cstdlib>
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <numeric>
+#include <optional>
+#include <random>
+#include <string>
+#include <vector>
+
+/**
+ * Бенчмарк запросов по подотрезкам: онлайн-запросы в разном порядке против пакетного режима query_batch
+ *
+ * Порядок запросов меняет только локальность обращений к таблице и массиву, поэтому онлайн-запросы
+ * меряются в одном потоке в трёх порядках: исходном, по порогу и по началу отрезка (как сортирует query_batch).
+ * Затем - сам query_batch на заданном числе потоков. Все ответы сверяются с онлайн-запросами в исходном порядке
+ *
+ * Пороги берутся из верхней тысячной доли диапазона значений, чтобы ответ был далеко от начала отрезка
+ */
+
+void print_usage(const char* prog_name) {
+    std::cout << "Использование: " << prog_name << " [размер_массива] [количество_запросов] [количество_потоков]" << std::endl;
+}
+
+int main(int argc, char* argv[]) {
+    std::size_t array_size = 10000000;
+    std::size_t num_queries = 1000000;
+    std::optional<int> num_threads = std::nullopt;
+
+    if (argc > 4) {
+        std::cerr << "Ошибка: слишком много аргументов" << std::endl;
+        print_usage(argv[0]);
+        return 1;
+    }
+    if (argc >= 2 && (std::string(argv[1]) == "-h" || std::string(argv[1]) == "--help")) {
+        print_usage(argv[0]);
+        return 0;
+    }
+    if (argc >= 2) {
+        array_size = std::strtoull(argv[1], nullptr, 10);
+    }
+    if (argc >= 3) {
+        num_queries = std::strtoull(argv[2], nullptr, 10);
+    }
+    if (argc >= 4) {
+        num_threads = std::atoi(argv[3]);
+    }
+    if (array_size == 0 || num_queries == 0) {
+        std::cerr << "Ошибка: размер массива и количество запросов должны быть положительными" << std::endl;
+        return 1;
+    }
+
+    const long long value_range = 1000000000LL;
+    std::vector<long long> arr(array_size);
+    std::mt19937_64 gen(42);
+    std::uniform_int_distribution<long long> value_distr(0, value_range - 1);
+    std::generate(arr.begin(), arr.end(), [&]() { return value_distr(gen); });
+
+    // Отрезки [begin, end) со случайным началом и случайной длиной до конца массива
+    std::vector<RangeQuery<long long>> queries(num_queries);
+    std::uniform_int_distribution<long long> threshold_distr(value_range - value_range / 1000, value_range - 1);
+    for (auto& q : queries) {
+        q.begin = gen() % array_size;
+        q.end = q.begin + gen() % (array_size - q.begin + 1);
+        q.threshold = threshold_distr(gen);
+    }
+
+    using clock = std::chrono::steady_clock;
+    auto nanos = [](clock::duration d) {
+        return std::chrono::duration<double, std::nano>(d).count();
+    };
+
+    RangeQuerySolver<long long> solver(num_threads);
+    auto start = clock::now();
+    solver.build(arr);
+    double build_time = nanos(clock::now() - start) / 1e6;
+
+    // Онлайн-запросы в заданном порядке; ответы - в исходном порядке запросов
+    std::vector<std::optional<RangeAnswer<long long>>> expected(num_queries);
+    auto run_online = [&](const std::vector<std::size_t>& order, std::vector<std::optional<RangeAnswer<long long>>>& answers) {
+        auto begin = clock::now();
+        for (std::size_t i : order) {
+            const auto& q = queries[i];
+            answers[i] = solver.query(q.begin, q.end, q.threshold);
+        }
+        return nanos(clock::now() - begin) / num_queries;
+    };
+    auto same = [&](const std::vector<std::optional<RangeAnswer<long long>>>& answers) {
+        for (std::size_t i = 0; i < num_queries; i++) {
+            if (answers[i].has_value() != expected[i].has_value() ||
+                (answers[i].has_value() && answers[i]->index != expected[i]->index)) {
+                return false;
+            }
+        }
+        return true;
+    };
+
+    std::vector<std::size_t> order(num_queries);
+    std::iota(order.begin(), order.end(), std::size_t{0});
+    double online_time = run_online(order, expected);
+
+    std::vector<std::optional<RangeAnswer<long long>>> answers(num_queries);
+    std::sort(order.begin(), order.end(), [&queries](std::size_t a, std::size_t b) {
+        return queries[a].threshold < queries[b].threshold;
+    });
+    double by_threshold_time = run_online(order, answers);
+    bool correct = same(answers);
+
+    std::sort(order.begin(), order.end(), [&queries](std::size_t a, std::size_t b) {
+        if (queries[a].begin != queries[b].begin) {
+            return queries[a].begin < queries[b].begin;
+        }
+        return queries[a].threshold < queries[b].threshold;
+    });
+    double by_begin_time = run_online(order, answers);
+    correct = correct && same(answers);
+
+    // Пакетный режим: сортировка входит во время
+    start = clock::now();
+    answers = solver.query_batch(queries);
+    double batch_time = nanos(clock::now() - start) / num_queries;
+    correct = correct && same(answers);
+
+    std::cout << "Размер массива:           " << array_size << std::endl;
+    std::cout << "Количество запросов:      " << num_queries << std::endl;
+    std::cout << "Реализация:               " << solver.get_name() << std::endl;
+    std::cout << "========================================" << std::endl;
+    std::cout << "Построение таблицы:       " << build_time << " мс" << std::endl;
+    std::cout << "Онлайн, исходный порядок: " << online_time << " нс на запрос" << std::endl;
+    std::cout << "Онлайн, по порогу:        " << by_threshold_time << " нс на запрос" << std::endl;
+    std::cout << "Онлайн, по началу:        " << by_begin_time << " нс на запрос" << std::endl;
+    std::cout << "query_batch:              " << batch_time << " нс на запрос (с сортировкой)" << std::endl;
+
+    if (!correct) {
+        std::cerr << "Ошибка: ответы в разном порядке или пакетного режима не совпадают" << std::endl;
+        return 1;
+    }
+    return 0;
+}
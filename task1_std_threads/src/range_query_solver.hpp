@@ -0,0 +1,251 @@
+#pragma once
+
+#include "base_solver.hpp"
+#include "chunking.hpp"
+#include "simd_search.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <numeric>
+#include <optional>
+#include <span>
+#include <thread>
+#include <vector>
+
+
+/**
+ * Запрос "первый элемент больше threshold в подотрезке [begin, end)"
+ */
+template<typename T>
+struct RangeQuery {
+    std::size_t begin = 0;
+    std::size_t end = 0;
+    T threshold {};
+};
+
+/**
+ * Ответ на запрос по подотрезку: индекс в массиве и значение
+ */
+template<typename T>
+struct RangeAnswer {
+    std::size_t index = 0;
+    T value {};
+};
+
+/**
+ * Запросы по подотрезкам: первый элемент больше порога в [begin, end)
+ *
+ * Суть:
+ *   - массив делится на блоки по block_size элементов, для максимумов блоков строится разреженная таблица
+ *     (sparse table): table[k][b] = max(блоки b .. b + 2^k - 1)
+ *   - запрос: неполные блоки по краям отрезка просматриваются векторным ядром find_first_greater,
+ *     а первый полный блок с максимумом больше порога ищется жадными прыжками по степеням двойки:
+ *     пока окно из 2^k блоков целиком не больше порога - перепрыгиваем его, иначе уменьшаем k.
+ *     Это O(log n) обращений к таблице плюс просмотр одного блока
+ *   - онлайн-режим - query(begin, end, threshold) на каждый запрос
+ *   - пакетный (офлайн) режим - query_batch: запросы сортируются по началу отрезка (при равном начале - по порогу)
+ *     и делятся на части (split_into_chunks), которые потоки обрабатывают параллельно. Соседние запросы
+ *     читают одни и те же столбцы таблицы и блоки массива, и те остаются в кэше; сортировка только по порогу
+ *     такой локальности не даёт - путь по таблице определяется положением отрезка. Ответы возвращаются
+ *     в исходном порядке запросов
+ *
+ * Построение - параллельное (std::thread), O(n) на максимумы блоков и O((n / block_size) log n) на таблицу.
+ * Индекс не отслеживает изменения массива: после изменения элементов нужно заново вызвать build.
+ * solve (интерфейс BaseSolver) состояния между вызовами не хранит и строит таблицу на каждый вызов;
+ * переиспользовать таблицу можно только явно - build, затем query / query_batch
+ */
+template<typename T>
+class RangeQuerySolver : public BaseSolver<T> {
+public:
+    /**
+     * Конструктор
+     * @param num_threads количество потоков для построения и пакетных запросов
+     *                    (опционально, если не указано - используется значение hardware_concurrency)
+     * @param block_size сколько элементов приходится на один максимум в таблице
+     */
+    explicit RangeQuerySolver(std::optional<int> num_threads = std::nullopt, std::size_t block_size = 64)
+        : block_size_(std::max<std::size_t>(block_size, 1)) {
+        if (num_threads.has_value()) {
+            num_threads_ = std::max(num_threads.value(), 1);
+        } else {
+            auto hc = std::thread::hardware_concurrency();
+            if (hc == 0) {
+                num_threads_ = 2; // fallback на случай, если hardware_concurrency не работает
+            } else {
+                num_threads_ = hc;
+            }
+        }
+    }
+
+    /**
+     * Построить разреженную таблицу максимумов блоков для массива (массив должен жить, пока идут запросы)
+     */
+    void build(std::span<const T> arr) {
+        data_ = arr;
+        std::size_t blocks = (arr.size() + block_size_ - 1) / block_size_;
+        table_.assign(blocks == 0 ? 0 : std::bit_width(blocks), std::vector<T>());
+        if (blocks == 0) {
+            return;
+        }
+
+        // Уровень 0 - максимумы блоков
+        table_[0].resize(blocks);
+        run_chunks(blocks, [&](std::size_t b) {
+            std::size_t begin = b * block_size_;
+            std::size_t end = std::min(begin + block_size_, arr.size());
+            table_[0][b] = *std::max_element(arr.begin() + begin, arr.begin() + end);
+        });
+
+        // Уровень k - максимумы окон из 2^k блоков, из двух окон уровня k - 1
+        for (std::size_t k = 1; k < table_.size(); k++) {
+            std::size_t half = std::size_t{1} << (k - 1);
+            std::size_t count = blocks - (std::size_t{1} << k) + 1;
+            table_[k].resize(count);
+            const std::vector<T>& prev = table_[k - 1];
+            std::vector<T>& level = table_[k];
+            run_chunks(count, [&](std::size_t b) {
+                level[b] = std::max(prev[b], prev[b + half]);
+            });
+        }
+    }
+
+    std::optional<T> solve(std::span<const T> arr, T threshold) override {
+        build(arr);
+        auto answer = query(0, arr.size(), threshold);
+        if (!answer.has_value()) {
+            return std::nullopt;
+        }
+        return answer->value;
+    }
+
+    /**
+     * Онлайн-запрос к построенной таблице: первый элемент больше threshold в [begin, end)
+     * @return индекс и значение, или std::nullopt, если такого элемента нет
+     */
+    std::optional<RangeAnswer<T>> query(std::size_t begin, std::size_t end, T threshold) const {
+        end = std::min(end, data_.size());
+        if (begin >= end) {
+            return std::nullopt;
+        }
+
+        std::size_t first_full = (begin + block_size_ - 1) / block_size_;
+        std::size_t last_full = end / block_size_;
+        if (first_full >= last_full) {
+            // Отрезок не содержит полных блоков - просто просматриваем его
+            return scan(begin, end, threshold);
+        }
+
+        // Неполный блок слева
+        if (auto head = scan(begin, first_full * block_size_, threshold)) {
+            return head;
+        }
+        // Полные блоки [first_full, last_full)
+        std::size_t block = find_block(first_full, last_full, threshold);
+        if (block != last_full) {
+            return scan(block * block_size_, (block + 1) * block_size_, threshold);
+        }
+        // Неполный блок справа
+        return scan(last_full * block_size_, end, threshold);
+    }
+
+    /**
+     * Пакетный (офлайн) режим: все запросы сразу, параллельно
+     * @return ответы в порядке queries
+     */
+    std::vector<std::optional<RangeAnswer<T>>> query_batch(std::span<const RangeQuery<T>> queries) const {
+        std::vector<std::optional<RangeAnswer<T>>> answers(queries.size());
+        if (queries.empty()) {
+            return answers;
+        }
+
+        // Порядок обработки - по началу отрезка, затем по порогу
+        std::vector<std::size_t> order(queries.size());
+        std::iota(order.begin(), order.end(), std::size_t{0});
+        std::sort(order.begin(), order.end(), [&queries](std::size_t a, std::size_t b) {
+            if (queries[a].begin != queries[b].begin) {
+                return queries[a].begin < queries[b].begin;
+            }
+            return queries[a].threshold < queries[b].threshold;
+        });
+
+        // Каждый поток пишет только ответы своих запросов - без синхронизации
+        run_chunks(queries.size(), [&](std::size_t i) {
+            const RangeQuery<T>& q = queries[order[i]];
+            answers[order[i]] = query(q.begin, q.end, q.threshold);
+        });
+        return answers;
+    }
+
+    std::string get_name() const override {
+        return "Запросы по подотрезкам: разреженная таблица максимумов блоков (" + std::to_string(num_threads_) + " потоков)";
+    }
+
+private:
+    /**
+     * Просмотреть data_[begin, end) векторным ядром
+     */
+    std::optional<RangeAnswer<T>> scan(std::size_t begin, std::size_t end, T threshold) const {
+        std::size_t offset = find_first_greater(data_.data() + begin, end - begin, threshold);
+        if (offset == end - begin) {
+            return std::nullopt;
+        }
+        return RangeAnswer<T>{begin + offset, data_[begin + offset]};
+    }
+
+    /**
+     * Первый блок из [first, last) с максимумом больше threshold, или last
+     * Жадные прыжки: окно из 2^k блоков, целиком не больше порога, перепрыгивается;
+     * если в окне есть подходящий блок, k уменьшается, пока окно не сузится до одного блока
+     */
+    std::size_t find_block(std::size_t first, std::size_t last, T threshold) const {
+        std::size_t b = first;
+        std::size_t k = std::bit_width(last - first) - 1;
+        while (b < last) {
+            while (b + (std::size_t{1} << k) > last) {
+                k--;
+            }
+            if (table_[k][b] <= threshold) {
+                b += std::size_t{1} << k;
+            } else if (k == 0) {
+                return b;
+            } else {
+                k--;
+            }
+        }
+        return last;
+    }
+
+    /**
+     * Выполнить func(i) для i = 0..count-1, разбив диапазон на части по потокам (split_into_chunks)
+     */
+    template<typename Func>
+    void run_chunks(std::size_t count, Func func) const {
+        std::size_t parts = std::min<std::size_t>(static_cast<std::size_t>(num_threads_), count);
+        if (parts <= 1) {
+            for (std::size_t i = 0; i < count; i++) {
+                func(i);
+            }
+            return;
+        }
+        std::vector<std::thread> threads;
+        threads.reserve(parts);
+        for (const ChunkRange& chunk : split_into_chunks(count, parts)) {
+            threads.emplace_back([&func, chunk] {
+                for (std::size_t i = chunk.begin; i < chunk.end; i++) {
+                    func(i);
+                }
+            });
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+    }
+
+private:
+    int num_threads_;
+    std::size_t block_size_;
+    // Массив, для которого построена таблица
+    std::span<const T> data_;
+    // table_[k][b] - максимум блоков [b, b + 2^k)
+    std::vector<std::vector<T>> table_;
+};
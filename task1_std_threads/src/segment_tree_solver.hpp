@@ -0,0 +1,228 @@
+#pragma once
+
+#include "base_solver.hpp"
+
+#include <algorithm>
+#include <limits>
+#include <thread>
+#include <optional>
+#include <utility>
+#include <vector>
+
+
+/**
+ * Решение задачи через дерево отрезков по максимуму - для изменяемых массивов
+ * (в отличие от PrefixMaxSolver, значения можно менять между запросами без перестроения)
+ *
+ * Раскладка в памяти - неявная "кучевая" (Эйтцингер / BFS-порядок):
+ *   - tree_[1] - корень, у узла v дети 2v и 2v + 1, листья - tree_[leaves_ + i]
+ *   - число листьев округлено вверх до степени двойки, лишние листья заполнены минимальным значением T
+ *   - верхние уровни дерева лежат в памяти подряд и почти всегда в кэше, указателей нет
+ *
+ * Операции:
+ *   - build(arr) - параллельное построение снизу вверх за O(n)
+ *   - update(i, v) - изменение элемента за O(log n)
+ *   - update_batch(updates) - пакет изменений: листья меняются сразу, затем каждый затронутый узел
+ *     пересчитывается ровно один раз, уровень за уровнем (большие уровни - параллельно)
+ *   - first_greater(t) / first_greater(t, from) - спуск по дереву за O(log n)
+ *   - solve(arr, threshold) - без состояния между вызовами: строит дерево заново (массив мог измениться
+ *     по тому же адресу). Дерево переиспользуется только явно: build, затем update / update_batch и first_greater
+ */
+template<typename T>
+class SegmentTreeSolver : public BaseSolver<T> {
+public:
+    // Индекс, означающий "элемент не найден"
+    static constexpr std::size_t kNotFound = std::numeric_limits<std::size_t>::max();
+
+    /**
+     * Конструктор
+     * @param num_threads количество потоков для построения и пакетных изменений
+     *                    (опционально, если не указано - используется значение hardware_concurrency)
+     */
+    explicit SegmentTreeSolver(std::optional<int> num_threads = std::nullopt) {
+        if (num_threads.has_value()) {
+            num_threads_ = std::max(num_threads.value(), 1);
+        } else {
+            auto hc = std::thread::hardware_concurrency();
+            if (hc == 0) {
+                num_threads_ = 2; // fallback на случай, если hardware_concurrency не работает
+            } else {
+                num_threads_ = hc;
+            }
+        }
+    }
+
+    /**
+     * Построить дерево по массиву
+     */
+    void build(std::span<const T> arr) {
+        size_ = arr.size();
+        leaves_ = 1;
+        while (leaves_ < size_) {
+            leaves_ *= 2;
+        }
+        tree_.assign(2 * leaves_, std::numeric_limits<T>::lowest());
+
+        // Листья
+        parallel_for(0, size_, [&](std::size_t i) {
+            tree_[leaves_ + i] = arr[i];
+        });
+        // Внутренние узлы - уровень за уровнем снизу вверх, узлы одного уровня независимы
+        for (std::size_t level_begin = leaves_ / 2; level_begin >= 1; level_begin /= 2) {
+            parallel_for(level_begin, 2 * level_begin, [&](std::size_t v) {
+                tree_[v] = std::max(tree_[2 * v], tree_[2 * v + 1]);
+            });
+        }
+    }
+
+    /**
+     * Изменить элемент с индексом index на value
+     */
+    void update(std::size_t index, T value) {
+        std::size_t v = leaves_ + index;
+        tree_[v] = value;
+        for (v /= 2; v >= 1; v /= 2) {
+            tree_[v] = std::max(tree_[2 * v], tree_[2 * v + 1]);
+        }
+    }
+
+    /**
+     * Пакет изменений (индекс, новое значение); при повторе индекса побеждает последнее значение
+     */
+    void update_batch(const std::vector<std::pair<std::size_t, T>>& updates) {
+        std::vector<std::size_t> nodes;
+        nodes.reserve(updates.size());
+        for (const auto& [index, value] : updates) {
+            tree_[leaves_ + index] = value;
+            nodes.push_back((leaves_ + index) / 2);
+        }
+
+        // Поднимаемся по уровням: на каждом уровне пересчитываем каждый затронутый узел один раз
+        while (!nodes.empty() && nodes.front() >= 1) {
+            std::sort(nodes.begin(), nodes.end());
+            nodes.erase(std::unique(nodes.begin(), nodes.end()), nodes.end());
+
+            parallel_for(0, nodes.size(), [&](std::size_t k) {
+                std::size_t v = nodes[k];
+                tree_[v] = std::max(tree_[2 * v], tree_[2 * v + 1]);
+            });
+
+            if (nodes.front() == 1) {
+                break;
+            }
+            for (auto& v : nodes) {
+                v /= 2;
+            }
+        }
+    }
+
+    /**
+     * Индекс первого элемента, большего threshold, или kNotFound
+     */
+    std::size_t first_greater(T threshold) const {
+        if (size_ == 0 || tree_[1] <= threshold) {
+            return kNotFound;
+        }
+        return descend(1, threshold);
+    }
+
+    /**
+     * Индекс первого элемента с индексом не меньше from, большего threshold, или kNotFound
+     *
+     * Идём от листа from вверх: если текущий узел не подходит, переходим к ближайшему
+     * поддереву правее (поднимаясь, пока узел - правый ребёнок); как только нашли узел с максимумом > threshold,
+     * спускаемся в его самый левый подходящий лист
+     */
+    std::size_t first_greater(T threshold, std::size_t from) const {
+        if (from >= size_) {
+            return kNotFound;
+        }
+        std::size_t v = leaves_ + from;
+        while (tree_[v] <= threshold) {
+            while (v % 2 == 1) {
+                v /= 2;
+            }
+            // Поднялись выше корня - правее ничего не осталось
+            if (v == 0) {
+                return kNotFound;
+            }
+            v++;
+        }
+        return descend(v, threshold);
+    }
+
+    /**
+     * Текущее значение элемента с индексом index
+     */
+    T value(std::size_t index) const {
+        return tree_[leaves_ + index];
+    }
+
+    /**
+     * Количество элементов
+     */
+    std::size_t size() const {
+        return size_;
+    }
+
+    std::optional<T> solve(std::span<const T> arr, T threshold) override {
+        build(arr);
+        std::size_t index = first_greater(threshold);
+        if (index == kNotFound) {
+            return std::nullopt;
+        }
+        return value(index);
+    }
+
+    std::string get_name() const override {
+        return "Дерево отрезков по максимуму (построение в " + std::to_string(num_threads_) + " потоков)";
+    }
+
+private:
+    /**
+     * Спуск от узла v (максимум которого > threshold) к самому левому листу со значением > threshold
+     */
+    std::size_t descend(std::size_t v, T threshold) const {
+        while (v < leaves_) {
+            v = (tree_[2 * v] > threshold) ? 2 * v : 2 * v + 1;
+        }
+        return v - leaves_;
+    }
+
+    /**
+     * Выполнить func(i) для i из [begin, end): параллельно, если диапазон достаточно большой
+     */
+    template<typename Func>
+    void parallel_for(std::size_t begin, std::size_t end, Func func) const {
+        // Меньше этого порога запуск потоков дороже самой работы
+        constexpr std::size_t kMinParallelRange = 1 << 16;
+        std::size_t count = end - begin;
+        if (num_threads_ == 1 || count < kMinParallelRange) {
+            for (std::size_t i = begin; i < end; i++) {
+                func(i);
+            }
+            return;
+        }
+
+        std::vector<std::thread> threads;
+        threads.reserve(num_threads_);
+        for (int part = 0; part < num_threads_; part++) {
+            std::size_t part_begin = begin + count * part / num_threads_;
+            std::size_t part_end = begin + count * (part + 1) / num_threads_;
+            threads.emplace_back([&func, part_begin, part_end] {
+                for (std::size_t i = part_begin; i < part_end; i++) {
+                    func(i);
+                }
+            });
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+    }
+
+private:
+    int num_threads_;
+    std::size_t size_ = 0;
+    std::size_t leaves_ = 1;
+    std::vector<T> tree_;
+};
@@ -1,20 +1,34 @@
 #pragma once
 
 #include "base_solver.hpp"
+#include "block_max_summary.hpp"
+#include "predicates.hpp"
+
+#include <cassert>
 
 /**
  * Последовательная реализация задачи
  * Использует примитивный проход по массиву слева направо
  * Если нашли нужный элемент - возвращаем его
  * Если не нашли - возвращаем std::nullopt в конце функции
+ * Если подключена сводка максимумов по блокам (attach_summary) - блоки с максимумом <= порога пропускаются
  */
 template<typename T>
 class SequentialSolver : public BaseSolver<T> {
 public:
-    std::optional<T> solve(const std::vector<T>& arr, T threshold) override {
+    std::optional<T> solve(std::span<const T> arr, T threshold) override {
         if (arr.empty()) {
             return std::nullopt;
         }
+
+        if (summary_ != nullptr) {
+            assert(summary_->size() == arr.size());
+            std::size_t index = summary_->find_first_greater(arr.data(), 0, arr.size(), threshold);
+            if (index == arr.size()) {
+                return std::nullopt;
+            }
+            return arr[index];
+        }
         
         for (std::size_t i = 0; i < arr.size(); i++) {
             if (arr[i] > threshold) {
@@ -25,7 +39,33 @@ public:
         return std::nullopt;
     }
     
+    /**
+     * Первый элемент, для которого pred истинно (предикаты - см. predicates.hpp)
+     * Тот же примитивный проход, но условие - политика, подставляемая во время компиляции
+     */
+    template<typename Pred>
+    std::optional<T> find_first(std::span<const T> arr, const Pred& pred) {
+        for (std::size_t i = 0; i < arr.size(); i++) {
+            if (pred(arr[i])) {
+                return arr[i];
+            }
+        }
+        return std::nullopt;
+    }
+    
     std::string get_name() const override {
         return "Последовательная версия";
     }
+
+    /**
+     * Подключить сводку максимумов по блокам (не владеющий указатель, nullptr - отключить)
+     * Контракт: сводка построена по тому же массиву, что передаётся в solve, и поддерживается через
+     * BlockMaxSummary::update (или build) при каждом его изменении - иначе блоки с совпадениями будут пропущены
+     */
+    void attach_summary(const BlockMaxSummary<T>* summary) {
+        summary_ = summary;
+    }
+
+private:
+    const BlockMaxSummary<T>* summary_ = nullptr;
 };
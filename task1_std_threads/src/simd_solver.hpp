@@ -0,0 +1,41 @@
+#pragma once
+
+#include "base_solver.hpp"
+#include "predicates.hpp"
+#include "simd_search.hpp"
+
+#include <string>
+
+/**
+ * Последовательная реализация задачи на векторных инструкциях
+ * Проходит массив слева направо ядром find_first_greater из simd_search.hpp:
+ * сравнивает 4 (AVX2) или 8 (AVX-512) элементов за инструкцию,
+ * так что поиск упирается в пропускную способность памяти, а не в сравнения
+ */
+class SimdSolver : public BaseSolver<long long> {
+public:
+    std::optional<long long> solve(std::span<const long long> arr, long long threshold) override {
+        std::size_t index = find_first_greater(arr.data(), arr.size(), threshold);
+        if (index == arr.size()) {
+            return std::nullopt;
+        }
+        return arr[index];
+    }
+
+    /**
+     * Первый элемент, для которого pred истинно (предикаты - см. predicates.hpp)
+     * Для каждого типа предиката собирается своё векторное ядро find_first_if
+     */
+    template<typename Pred>
+    std::optional<long long> find_first(std::span<const long long> arr, const Pred& pred) {
+        std::size_t index = find_first_if(arr.data(), arr.size(), pred);
+        if (index == arr.size()) {
+            return std::nullopt;
+        }
+        return arr[index];
+    }
+
+    std::string get_name() const override {
+        return std::string("Последовательная SIMD-версия (") + simd_kernel_name() + ")";
+    }
+};
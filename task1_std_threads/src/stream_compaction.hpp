@@ -0,0 +1,250 @@
+#pragma once
+
+#include "chunking.hpp"
+#include "cpu_features.hpp"
+#include "predicates.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <future>
+#include <span>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+/**
+ * Сжатие потока (stream compaction): индексы всех элементов, для которых pred истинно, по возрастанию,
+ * или только первых limit из них
+ *
+ * Параллельная схема в два прохода по тем же частям массива, что и у решателей (split_into_chunks):
+ *   1. каждый поток считает совпадения в своей части (не больше limit - дальше часть ничего не добавит)
+ *   2. по счётчикам частей считаются префиксные суммы - смещение каждой части в выходном массиве
+ *   3. каждый поток записывает индексы своей части начиная со своего смещения
+ * Потоки пишут в непересекающиеся отрезки заранее выделенного выходного массива,
+ * поэтому результат сразу упорядочен по индексу - без push_back, блокировок и сортировки.
+ * Части, целиком лежащие за первыми limit совпадениями, на втором проходе ничего не читают
+ */
+
+namespace compaction_detail {
+
+// Сколько элементов части считается между проверками "уже набрали limit совпадений"
+inline constexpr std::size_t kCountBlock = 4096;
+
+template<typename T, typename Pred>
+std::size_t count_if_portable(const T* data, std::size_t n, const Pred& pred) {
+    // Без ветвлений: сумма результатов предиката векторизуется компилятором
+    std::size_t count = 0;
+    for (std::size_t i = 0; i < n; i++) {
+        count += static_cast<std::size_t>(pred(data[i]));
+    }
+    return count;
+}
+
+/**
+ * Переносимая запись индексов без ветвлений: индекс пишется всегда, а позиция записи
+ * сдвигается, только если предикат истинен (out[count] существует, пока count < limit)
+ */
+template<typename T, typename Pred>
+std::size_t write_indices_portable(const T* data, std::size_t n, const Pred& pred,
+                                   std::size_t base, std::size_t* out, std::size_t limit) {
+    std::size_t count = 0;
+    for (std::size_t i = 0; i < n && count < limit; i++) {
+        out[count] = base + i;
+        count += static_cast<std::size_t>(pred(data[i]));
+    }
+    return count;
+}
+
+#if defined(SIMD_SEARCH_X86)
+
+template<typename Pred>
+PREDICATE_AVX512 std::size_t count_if_avx512(const long long* data, std::size_t n, const Pred& pred) {
+    std::size_t count = 0;
+    std::size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        count += __builtin_popcount(pred.avx512_mask(_mm512_loadu_si512(data + i)));
+    }
+    return count + count_if_portable(data + i, n - i, pred);
+}
+
+template<typename Pred>
+PREDICATE_AVX2 std::size_t count_if_avx2(const long long* data, std::size_t n, const Pred& pred) {
+    std::size_t count = 0;
+    std::size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        count += __builtin_popcount(pred.avx2_mask(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i))));
+    }
+    return count + count_if_portable(data + i, n - i, pred);
+}
+
+/**
+ * AVX-512: маска сравнения по 8 элементам, и индексы совпавших элементов одной инструкцией
+ * _mm512_mask_compressstoreu_epi64 записываются подряд в выходной массив
+ */
+template<typename Pred>
+PREDICATE_AVX512 std::size_t write_indices_avx512(const long long* data, std::size_t n, const Pred& pred,
+                                                  std::size_t base, std::size_t* out, std::size_t limit) {
+    std::size_t count = 0;
+    std::size_t i = 0;
+    __m512i indices = _mm512_add_epi64(_mm512_set1_epi64(static_cast<long long>(base)),
+                                       _mm512_setr_epi64(0, 1, 2, 3, 4, 5, 6, 7));
+    const __m512i step = _mm512_set1_epi64(8);
+    for (; i + 8 <= n && count < limit; i += 8) {
+        unsigned mask = pred.avx512_mask(_mm512_loadu_si512(data + i));
+        std::size_t matched = static_cast<std::size_t>(__builtin_popcount(mask));
+        if (matched > limit - count) {
+            // Оставляем только младшие limit - count совпадений
+            unsigned kept = 0;
+            for (std::size_t k = 0; k < limit - count; k++) {
+                kept |= mask & (0u - mask);
+                mask &= mask - 1;
+            }
+            mask = kept;
+            matched = limit - count;
+        }
+        _mm512_mask_compressstoreu_epi64(out + count, static_cast<__mmask8>(mask), indices);
+        count += matched;
+        indices = _mm512_add_epi64(indices, step);
+    }
+    if (count < limit) {
+        count += write_indices_portable(data + i, n - i, pred, base + i, out + count, limit - count);
+    }
+    return count;
+}
+
+#endif // SIMD_SEARCH_X86
+
+} // namespace compaction_detail
+
+/**
+ * Число элементов data[0..n), для которых pred истинно
+ */
+template<typename T, typename Pred>
+std::size_t count_matches(const T* data, std::size_t n, const Pred& pred) {
+#if defined(SIMD_SEARCH_X86)
+    if constexpr (std::is_same_v<T, long long>) {
+        if constexpr (requires(const Pred& p, __m512i v) { p.avx512_mask(v); }) {
+            if (cpu_features().avx512f) {
+                return compaction_detail::count_if_avx512(data, n, pred);
+            }
+        }
+        if constexpr (requires(const Pred& p, __m256i v) { p.avx2_mask(v); }) {
+            if (cpu_features().avx2) {
+                return compaction_detail::count_if_avx2(data, n, pred);
+            }
+        }
+    }
+#endif
+    return compaction_detail::count_if_portable(data, n, pred);
+}
+
+/**
+ * Записать в out индексы (со сдвигом base) первых limit элементов data[0..n), для которых pred истинно
+ * @return сколько индексов записано (не больше limit)
+ */
+template<typename T, typename Pred>
+std::size_t write_matching_indices(const T* data, std::size_t n, const Pred& pred,
+                                   std::size_t base, std::size_t* out, std::size_t limit) {
+#if defined(SIMD_SEARCH_X86)
+    if constexpr (std::is_same_v<T, long long> && sizeof(std::size_t) == sizeof(long long)) {
+        if constexpr (requires(const Pred& p, __m512i v) { p.avx512_mask(v); }) {
+            if (cpu_features().avx512f) {
+                return compaction_detail::write_indices_avx512(data, n, pred, base, out, limit);
+            }
+        }
+    }
+#endif
+    return compaction_detail::write_indices_portable(data, n, pred, base, out, limit);
+}
+
+/**
+ * Параллельный отбор индексов: первые limit индексов элементов arr, для которых pred истинно, по возрастанию
+ *
+ * Выходной массив выделяет вызывающий: после подсчёта вызывается output(total), который должен вернуть
+ * указатель на место хотя бы под total индексов (total = min(число совпадений, limit)).
+ * Если output вернул nullptr, индексы не записываются - остаётся только параллельный подсчёт
+ *
+ * Потоки запускаются один раз: посчитав совпадения, поток отдаёт счётчик через future
+ * и ждёт от главного потока адрес выходного массива (shared_future), после чего пишет свои индексы
+ *
+ * @param arr массив чисел для поиска
+ * @param pred условие отбора (см. predicates.hpp)
+ * @param limit сколько первых совпадений нужно
+ * @param num_threads число потоков (> 0)
+ * @param output выделение выходного массива: size_t total -> size_t*
+ * @return сколько индексов записано
+ */
+template<typename T, typename Pred, typename Output>
+std::size_t parallel_select_indices(std::span<const T> arr, const Pred& pred, std::size_t limit,
+                                    int num_threads, Output&& output) {
+    if (arr.empty() || limit == 0) {
+        output(0);
+        return 0;
+    }
+
+    std::size_t actual_threads = std::min<std::size_t>(std::max(num_threads, 1), arr.size());
+    std::vector<ChunkRange> chunks = split_into_chunks(arr.size(), actual_threads);
+
+    // Смещения частей и адрес выходного массива становятся известны только после подсчёта,
+    // поэтому потоки получают их через shared_future
+    std::vector<std::size_t> offsets(actual_threads + 1, 0);
+    std::promise<std::size_t*> destination_promise;
+    std::shared_future<std::size_t*> destination = destination_promise.get_future().share();
+
+    std::vector<std::thread> threads;
+    std::vector<std::future<std::size_t>> counts;
+    threads.reserve(actual_threads);
+    counts.reserve(actual_threads);
+
+    for (std::size_t t = 0; t < actual_threads; t++) {
+        std::promise<std::size_t> count_promise;
+        counts.push_back(count_promise.get_future());
+        threads.emplace_back(
+            [&arr, &pred, &offsets, destination, limit, chunk = chunks[t], t](std::promise<std::size_t> result_promise) {
+                // Проход 1: подсчёт совпадений в части (не больше limit)
+                std::size_t count = 0;
+                for (std::size_t block = chunk.begin; block < chunk.end && count < limit;
+                     block += compaction_detail::kCountBlock) {
+                    std::size_t block_len = std::min(compaction_detail::kCountBlock, chunk.end - block);
+                    count += count_matches(arr.data() + block, block_len, pred);
+                }
+                count = std::min(count, limit);
+                result_promise.set_value(count);
+
+                // Проход 2: запись индексов со своего смещения
+                std::size_t* out = destination.get();
+                std::size_t total = offsets.back();
+                if (out == nullptr || offsets[t] >= total) {
+                    return;
+                }
+                write_matching_indices(arr.data() + chunk.begin, chunk.size(), pred, chunk.begin,
+                                       out + offsets[t], std::min(count, total - offsets[t]));
+            },
+            std::move(count_promise)
+        );
+    }
+
+    // Префиксные суммы по счётчикам частей; offsets.back() - сколько индексов будет записано
+    for (std::size_t t = 0; t < actual_threads; t++) {
+        offsets[t + 1] = offsets[t] + counts[t].get();
+    }
+    offsets.back() = std::min(offsets.back(), limit);
+
+    std::size_t* out = nullptr;
+    try {
+        out = output(offsets.back());
+    } catch (...) {
+        // Выделить память не удалось - отпускаем потоки без записи
+        destination_promise.set_value(nullptr);
+        for (auto& thread : threads) {
+            thread.join();
+        }
+        throw;
+    }
+    destination_promise.set_value(out);
+
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    return offsets.back();
+}
@@ -0,0 +1,307 @@
+#pragma once
+
+#include "multi_threshold.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <thread>
+#include <vector>
+
+/**
+ * Совпадение в потоке: первое значение больше порога подписки
+ */
+template<typename T>
+struct StreamMatch {
+    // Номер подписки (возвращается subscribe)
+    std::uint64_t subscription = 0;
+    T threshold {};
+    // Глобальный индекс значения в потоке (с начала работы движка)
+    std::uint64_t index = 0;
+    T value {};
+};
+
+/**
+ * Потоковый режим: значения поступают блоками, и на каждый зарегистрированный порог нужно узнать
+ * первое значение больше него, как только оно появится
+ *
+ * Суть:
+ *   - два буфера по block_size значений (двойная буферизация): производитель (push) заполняет один,
+ *     пока поток-потребитель проверяет другой; производитель ждёт, только если потребитель не успевает
+ *   - каждое значение проверяется ровно один раз, когда его блок проходит потребитель, и нигде не хранится
+ *     после этого - память ограничена двумя блоками и числом подписок, а не длиной потока
+ *   - открытые пороги хранятся по возрастанию, и блок проверяется тем же проходом, что solve_many (scan_many):
+ *     векторным ядром find_first_greater ищется элемент больше наименьшего открытого порога,
+ *     и он сразу закрывает все пороги меньше себя. Проход по блоку останавливается, как только открытых порогов
+ *     не осталось, а без открытых порогов блок вообще не читается
+ *   - подписка учитывает значения, поступившие после вызова subscribe: её порог становится открытым
+ *     с того глобального индекса, до которого к этому моменту дошёл производитель
+ *
+ * Совпадения передаются в обработчик on_match (вызывается из потока-потребителя до того, как блок считается
+ * проверенным, поэтому из обработчика нельзя вызывать push и flush) или, если обработчик не задан,
+ * копятся до вызова take_matches. Каждая подписка срабатывает один раз
+ */
+template<typename T>
+class StreamEngine {
+public:
+    using MatchHandler = std::function<void(const StreamMatch<T>&)>;
+
+    /**
+     * Конструктор
+     * @param block_size размер блока (сколько значений проверяется за раз)
+     * @param on_match обработчик совпадений (опционально)
+     */
+    explicit StreamEngine(std::size_t block_size = 1 << 16, MatchHandler on_match = nullptr)
+        : block_size_(std::max<std::size_t>(block_size, 1)), on_match_(std::move(on_match)) {
+        buffers_[0] = std::make_unique_for_overwrite<T[]>(block_size_);
+        buffers_[1] = std::make_unique_for_overwrite<T[]>(block_size_);
+        consumer_ = std::thread(&StreamEngine::consumer_loop, this);
+    }
+
+    // Поток-потребитель держит указатель this - копирование и перемещение запрещены
+    StreamEngine(const StreamEngine&) = delete;
+    StreamEngine& operator=(const StreamEngine&) = delete;
+
+    /**
+     * Деструктор: дожидается проверки всех поступивших значений и останавливает потребителя
+     */
+    ~StreamEngine() {
+        flush();
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stopping_ = true;
+        }
+        cv_.notify_all();
+        consumer_.join();
+    }
+
+    /**
+     * Зарегистрировать порог: сработает на первом значении больше threshold среди поступивших после этого вызова
+     * @return номер подписки
+     */
+    std::uint64_t subscribe(T threshold) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        std::uint64_t id = next_subscription_++;
+        pending_.push_back(Subscription{id, threshold, pushed_.load(std::memory_order_relaxed)});
+        return id;
+    }
+
+    /**
+     * Добавить значения в поток (вызывается из одного потока-производителя)
+     * Полный блок передаётся потребителю; если тот ещё проверяет предыдущий блок - ждём его
+     */
+    void push(std::span<const T> values) {
+        while (!values.empty()) {
+            std::size_t count = std::min(values.size(), block_size_ - fill_size_);
+            std::copy_n(values.data(), count, buffers_[fill_].get() + fill_size_);
+            fill_size_ += count;
+            pushed_.fetch_add(count, std::memory_order_relaxed);
+            values = values.subspan(count);
+
+            if (fill_size_ == block_size_) {
+                submit_block();
+            }
+        }
+    }
+
+    /**
+     * Передать потребителю неполный блок и дождаться проверки всего поступившего
+     * После flush все совпадения по уже добавленным значениям переданы в on_match / take_matches
+     */
+    void flush() {
+        if (fill_size_ > 0) {
+            submit_block();
+        }
+        std::unique_lock<std::mutex> lock(mutex_);
+        cv_.wait(lock, [this] { return !in_flight_; });
+    }
+
+    /**
+     * Забрать накопленные совпадения (если обработчик on_match не задан)
+     */
+    std::vector<StreamMatch<T>> take_matches() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        std::vector<StreamMatch<T>> matches;
+        matches.swap(matches_);
+        return matches;
+    }
+
+    /**
+     * Сколько значений добавлено и сколько из них уже проверено
+     */
+    std::uint64_t values_pushed() const {
+        return pushed_.load(std::memory_order_relaxed);
+    }
+
+    std::uint64_t values_checked() const {
+        return checked_.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * Сколько подписок ещё не сработало
+     */
+    std::size_t open_subscriptions() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return pending_.size() + open_count_;
+    }
+
+private:
+    struct Subscription {
+        std::uint64_t id;
+        T threshold;
+        // С какого глобального индекса подписка учитывает значения
+        std::uint64_t from_index;
+    };
+
+    /**
+     * Отдать заполненный буфер потребителю и переключиться на второй
+     */
+    void submit_block() {
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            cv_.wait(lock, [this] { return !in_flight_; });
+            in_flight_ = true;
+            block_buffer_ = fill_;
+            block_size_ready_ = fill_size_;
+            block_base_ = submitted_;
+        }
+        cv_.notify_all();
+        submitted_ += fill_size_;
+        fill_ ^= 1;
+        fill_size_ = 0;
+    }
+
+    void consumer_loop() {
+        while (true) {
+            const T* data = nullptr;
+            std::size_t size = 0;
+            std::uint64_t base = 0;
+            std::vector<Subscription> arrived;
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                cv_.wait(lock, [this] { return stopping_ || in_flight_; });
+                if (!in_flight_) {
+                    // stopping_ == true и блоков больше нет
+                    return;
+                }
+                data = buffers_[block_buffer_].get();
+                size = block_size_ready_;
+                base = block_base_;
+                // Новые подписки переходят к потребителю; их from_index не убывает
+                arrived.assign(pending_.begin(), pending_.end());
+                pending_.clear();
+                open_count_ += arrived.size();
+            }
+            waiting_.insert(waiting_.end(), arrived.begin(), arrived.end());
+
+            std::vector<StreamMatch<T>> matches = check_block(data, size, base);
+
+            // Обработчик вызывается до снятия in_flight_: когда flush вернётся, все совпадения уже доставлены
+            if (on_match_) {
+                for (const auto& match : matches) {
+                    on_match_(match);
+                }
+            }
+
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                open_count_ -= matches.size();
+                checked_.fetch_add(size, std::memory_order_relaxed);
+                in_flight_ = false;
+                if (!on_match_) {
+                    matches_.insert(matches_.end(), matches.begin(), matches.end());
+                }
+            }
+            cv_.notify_all();
+        }
+    }
+
+    /**
+     * Проверить блок data[0..size) с глобальным началом base
+     * Блок режется на отрезки по from_index ожидающих подписок: на каждом отрезке набор открытых порогов постоянен
+     */
+    std::vector<StreamMatch<T>> check_block(const T* data, std::size_t size, std::uint64_t base) {
+        std::vector<StreamMatch<T>> matches;
+        std::size_t pos = 0;
+        while (pos < size) {
+            // Подписки, начавшиеся не позже текущей позиции, становятся открытыми
+            while (!waiting_.empty() && waiting_.front().from_index <= base + pos) {
+                open_subscription(waiting_.front());
+                waiting_.pop_front();
+            }
+            std::size_t segment_end = size;
+            if (!waiting_.empty() && waiting_.front().from_index < base + size) {
+                segment_end = static_cast<std::size_t>(waiting_.front().from_index - base);
+            }
+
+            if (!open_values_.empty()) {
+                // Тот же проход, что в solve_many: найденные индексы образуют префикс открытых порогов
+                std::vector<std::size_t> found = scan_many(data, pos, segment_end, open_values_);
+                std::size_t closed = 0;
+                while (closed < found.size() && found[closed] != kNoMatch) {
+                    matches.push_back(StreamMatch<T>{open_ids_[closed], open_values_[closed],
+                                                     base + found[closed], data[found[closed]]});
+                    closed++;
+                }
+                open_values_.erase(open_values_.begin(), open_values_.begin() + closed);
+                open_ids_.erase(open_ids_.begin(), open_ids_.begin() + closed);
+            }
+            pos = segment_end;
+        }
+        return matches;
+    }
+
+    /**
+     * Вставить порог в открытые с сохранением порядка по возрастанию
+     */
+    void open_subscription(const Subscription& subscription) {
+        auto it = std::upper_bound(open_values_.begin(), open_values_.end(), subscription.threshold);
+        std::size_t at = static_cast<std::size_t>(it - open_values_.begin());
+        open_values_.insert(it, subscription.threshold);
+        open_ids_.insert(open_ids_.begin() + at, subscription.id);
+    }
+
+private:
+    std::size_t block_size_;
+    MatchHandler on_match_;
+
+    // Двойной буфер; fill_ - индекс буфера, который заполняет производитель
+    std::unique_ptr<T[]> buffers_[2];
+    std::size_t fill_ = 0;
+    std::size_t fill_size_ = 0;
+    // Сколько значений передано потребителю (только поток-производитель)
+    std::uint64_t submitted_ = 0;
+
+    // Блок, переданный потребителю: буфер, размер и глобальный индекс начала (под mutex_)
+    bool in_flight_ = false;
+    std::size_t block_buffer_ = 0;
+    std::size_t block_size_ready_ = 0;
+    std::uint64_t block_base_ = 0;
+    bool stopping_ = false;
+
+    // Подписки, ещё не переданные потребителю (под mutex_)
+    std::vector<Subscription> pending_;
+    std::uint64_t next_subscription_ = 0;
+    // Подписки у потребителя, ещё не сработавшие (под mutex_)
+    std::size_t open_count_ = 0;
+    std::vector<StreamMatch<T>> matches_;
+
+    // Состояние потребителя: подписки, ждущие своего from_index, и открытые пороги по возрастанию
+    std::deque<Subscription> waiting_;
+    std::vector<T> open_values_;
+    std::vector<std::uint64_t> open_ids_;
+
+    std::atomic<std::uint64_t> pushed_{0};
+    std::atomic<std::uint64_t> checked_{0};
+
+    mutable std::mutex mutex_;
+    std::condition_variable cv_;
+    std::thread consumer_;
+};
@@ -0,0 +1,131 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+
+/**
+ * Простой пул потоков фиксированного размера
+ *
+ * Суть:
+ *   - потоки создаются один раз в конструкторе и живут до разрушения пула
+ *   - между задачами потоки "паркуются" на condition_variable и не тратят процессор
+ *   - задачи кладутся в общую очередь FIFO, свободный поток забирает задачу из головы очереди
+ *   - результат задачи пул не возвращает: вызывающая сторона сама передаёт в задачу promise
+ */
+class ThreadPool {
+public:
+    /**
+     * Конструктор
+     * @param num_threads количество рабочих потоков (не меньше 1)
+     */
+    explicit ThreadPool(std::size_t num_threads) {
+        if (num_threads == 0) {
+            num_threads = 1;
+        }
+        workers_.reserve(num_threads);
+        for (std::size_t i = 0; i < num_threads; i++) {
+            workers_.emplace_back(&ThreadPool::worker_loop, this);
+        }
+    }
+
+    // Потоки держат указатель this - копирование и перемещение запрещены
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    /**
+     * Деструктор: дожидается выполнения всех поставленных задач и останавливает потоки
+     */
+    ~ThreadPool() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stopping_ = true;
+        }
+        cv_.notify_all();
+        for (auto& worker : workers_) {
+            worker.join();
+        }
+    }
+
+    /**
+     * Поставить задачу в очередь
+     */
+    void submit(std::function<void()> task) {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            tasks_.push_back(std::move(task));
+        }
+        cv_.notify_one();
+    }
+
+    /**
+     * Количество рабочих потоков в пуле
+     */
+    std::size_t size() const {
+        return workers_.size();
+    }
+
+    /**
+     * Количество задач, ожидающих в очереди (без учёта уже выполняющихся)
+     */
+    std::size_t queue_depth() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return tasks_.size();
+    }
+
+    /**
+     * Количество задач, выполняющихся прямо сейчас
+     */
+    std::size_t active_tasks() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return active_tasks_;
+    }
+
+    /**
+     * Общее количество выполненных задач за время жизни пула
+     */
+    std::size_t completed_tasks() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return completed_tasks_;
+    }
+
+private:
+    void worker_loop() {
+        while (true) {
+            std::function<void()> task;
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                cv_.wait(lock, [this] { return stopping_ || !tasks_.empty(); });
+                if (tasks_.empty()) {
+                    // stopping_ == true и задач больше нет
+                    return;
+                }
+                task = std::move(tasks_.front());
+                tasks_.pop_front();
+                active_tasks_++;
+            }
+
+            task();
+
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                active_tasks_--;
+                completed_tasks_++;
+            }
+        }
+    }
+
+private:
+    std::vector<std::thread> workers_;
+    std::deque<std::function<void()>> tasks_;
+    mutable std::mutex mutex_;
+    std::condition_variable cv_;
+    bool stopping_ = false;
+    std::size_t active_tasks_ = 0;
+    std::size_t completed_tasks_ = 0;
+};
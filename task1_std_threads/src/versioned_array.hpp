@@ -0,0 +1,356 @@
+#pragma once
+
+#include "chunking.hpp"
+#include "simd_search.hpp"
+#include "thread_pool.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <future>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+/**
+ * Неизменяемый снимок версионированного массива
+ *
+ * Массив хранится блоками по block_size элементов; каждый блок вместе со своим максимумом неизменяем
+ * и разделяется всеми версиями, в которых он не менялся. Снимок - список указателей на блоки.
+ * Пока снимок жив, его блоки не освобождаются (std::shared_ptr), даже если писатели уже опубликовали новые версии
+ */
+template<typename T>
+class ArraySnapshot {
+public:
+    struct Block {
+        std::vector<T> values;
+        T max;
+    };
+
+    ArraySnapshot(std::vector<std::shared_ptr<const Block>> blocks, std::size_t size,
+                  std::size_t block_size, std::uint64_t version)
+        : blocks_(std::move(blocks)), size_(size), block_size_(block_size), version_(version) {}
+
+    std::size_t size() const {
+        return size_;
+    }
+
+    /**
+     * Номер версии: увеличивается на каждую опубликованную запись
+     */
+    std::uint64_t version() const {
+        return version_;
+    }
+
+    std::size_t block_size() const {
+        return block_size_;
+    }
+
+    std::size_t block_count() const {
+        return blocks_.size();
+    }
+
+    std::span<const T> block(std::size_t b) const {
+        return blocks_[b]->values;
+    }
+
+    T block_max(std::size_t b) const {
+        return blocks_[b]->max;
+    }
+
+    T operator[](std::size_t index) const {
+        return blocks_[index / block_size_]->values[index % block_size_];
+    }
+
+    /**
+     * Первый индекс в блоках [first_block, last_block) с элементом больше threshold, или size(), если такого нет
+     * Блоки с максимумом <= threshold пропускаются без чтения
+     */
+    std::size_t find_first_greater(T threshold, std::size_t first_block, std::size_t last_block) const {
+        for (std::size_t b = first_block; b < last_block; b++) {
+            if (blocks_[b]->max <= threshold) {
+                continue;
+            }
+            const std::vector<T>& values = blocks_[b]->values;
+            std::size_t offset = ::find_first_greater(values.data(), values.size(), threshold);
+            if (offset != values.size()) {
+                return b * block_size_ + offset;
+            }
+        }
+        return size_;
+    }
+
+    std::size_t find_first_greater(T threshold) const {
+        return find_first_greater(threshold, 0, blocks_.size());
+    }
+
+private:
+    // Снимок не отдаёт указатели на блоки наружу; новую версию из них собирает только VersionedArray
+    template<typename> friend class VersionedArray;
+
+    std::vector<std::shared_ptr<const Block>> blocks_;
+    std::size_t size_;
+    std::size_t block_size_;
+    std::uint64_t version_;
+};
+
+/**
+ * Версионированный массив: поиск по согласованному снимку во время записи
+ *
+ * Суть:
+ *   - текущая версия - std::atomic<std::shared_ptr<const ArraySnapshot<T>>>; читатель берёт её одной загрузкой
+ *     (snapshot), а дальше ищет по неизменяемым блокам без блокировок, сколько бы записей ни прошло.
+ *     Сама загрузка не lock-free: в libstdc++ atomic<shared_ptr> защищает указатель и счётчик ссылок
+ *     короткой внутренней блокировкой (is_lock_free() == false), но держится она только на время копирования
+ *     указателя, а не на время поиска
+ *   - писатель копирует при записи (copy-on-write) только затронутые блоки, собирает новый список указателей
+ *     (нетронутые блоки разделяются со старой версией) и публикует его одной атомарной записью
+ *   - писатели сериализуются мьютексом между собой, но никогда не ждут читателей и не задерживают их:
+ *     читатель, взявший старый снимок, дочитывает его, а старые блоки освобождаются вместе с последним снимком,
+ *     который на них ссылается (подсчёт ссылок вместо эпох)
+ *   - у каждого блока хранится максимум, поэтому поиск пропускает блоки, в которых нет элемента больше порога
+ *
+ * Запись стоит O(число блоков) на копирование списка указателей плюс O(block_size) на каждый затронутый блок,
+ * поэтому изменения выгодно объединять в update_batch
+ */
+template<typename T>
+class VersionedArray {
+public:
+    using Snapshot = ArraySnapshot<T>;
+    using Block = typename Snapshot::Block;
+
+    /**
+     * Конструктор
+     * @param initial начальное содержимое (копируется)
+     * @param block_size размер блока копирования при записи
+     */
+    explicit VersionedArray(std::span<const T> initial = {}, std::size_t block_size = 4096)
+        : block_size_(std::max<std::size_t>(block_size, 1)) {
+        std::vector<std::shared_ptr<const Block>> blocks;
+        blocks.reserve((initial.size() + block_size_ - 1) / block_size_);
+        for (std::size_t begin = 0; begin < initial.size(); begin += block_size_) {
+            std::size_t end = std::min(begin + block_size_, initial.size());
+            blocks.push_back(make_block(std::vector<T>(initial.begin() + begin, initial.begin() + end)));
+        }
+        current_.store(std::make_shared<const Snapshot>(std::move(blocks), initial.size(), block_size_, 0));
+    }
+
+    VersionedArray(const VersionedArray&) = delete;
+    VersionedArray& operator=(const VersionedArray&) = delete;
+
+    /**
+     * Текущий снимок; писатели его уже не изменят
+     * Загрузка берёт внутреннюю блокировку atomic<shared_ptr> на время копирования указателя (не lock-free),
+     * поиск по полученному снимку блокировок не требует
+     */
+    std::shared_ptr<const Snapshot> snapshot() const {
+        return current_.load(std::memory_order_acquire);
+    }
+
+    std::uint64_t version() const {
+        return snapshot()->version();
+    }
+
+    /**
+     * Записать arr[index] = value (новая версия)
+     * @throws std::out_of_range если index >= size()
+     */
+    void update(std::size_t index, T value) {
+        update_batch({{index, value}});
+    }
+
+    /**
+     * Несколько записей одной новой версией: каждый затронутый блок копируется один раз
+     * @param updates пары (индекс, значение); при повторе индекса побеждает последняя запись
+     * @throws std::out_of_range если какой-либо индекс >= size(); тогда массив не меняется
+     */
+    void update_batch(const std::vector<std::pair<std::size_t, T>>& updates) {
+        if (updates.empty()) {
+            return;
+        }
+        std::lock_guard<std::mutex> lock(writer_mutex_);
+        auto old_snapshot = current_.load(std::memory_order_relaxed);
+        // Проверяем все индексы до копирования блоков: при ошибке версия не публикуется
+        for (const auto& update : updates) {
+            if (update.first >= old_snapshot->size()) {
+                throw std::out_of_range("VersionedArray: индекс " + std::to_string(update.first) +
+                                        " вне массива размера " + std::to_string(old_snapshot->size()));
+            }
+        }
+        std::vector<std::shared_ptr<const Block>> blocks = blocks_of(*old_snapshot);
+
+        // Группируем записи по блокам, сохраняя порядок записей внутри блока
+        std::vector<std::pair<std::size_t, T>> sorted = updates;
+        std::stable_sort(sorted.begin(), sorted.end(), [this](const auto& a, const auto& b) {
+            return a.first / block_size_ < b.first / block_size_;
+        });
+        for (std::size_t i = 0; i < sorted.size();) {
+            std::size_t b = sorted[i].first / block_size_;
+            std::vector<T> values = blocks[b]->values;
+            for (; i < sorted.size() && sorted[i].first / block_size_ == b; i++) {
+                values[sorted[i].first % block_size_] = sorted[i].second;
+            }
+            blocks[b] = make_block(std::move(values));
+        }
+
+        publish(std::move(blocks), old_snapshot->size(), old_snapshot->version() + 1);
+    }
+
+    /**
+     * Дописать значения в конец массива (новая версия)
+     * Копируется только последний, неполный блок; остальные добавляются новыми
+     */
+    void append(std::span<const T> values) {
+        if (values.empty()) {
+            return;
+        }
+        std::lock_guard<std::mutex> lock(writer_mutex_);
+        auto old_snapshot = current_.load(std::memory_order_relaxed);
+        std::vector<std::shared_ptr<const Block>> blocks = blocks_of(*old_snapshot);
+
+        std::size_t size = old_snapshot->size();
+        std::size_t consumed = 0;
+        if (size % block_size_ != 0) {
+            std::vector<T> tail = blocks.back()->values;
+            consumed = std::min(values.size(), block_size_ - tail.size());
+            tail.insert(tail.end(), values.begin(), values.begin() + consumed);
+            blocks.back() = make_block(std::move(tail));
+        }
+        while (consumed < values.size()) {
+            std::size_t count = std::min(block_size_, values.size() - consumed);
+            blocks.push_back(make_block(std::vector<T>(values.begin() + consumed, values.begin() + consumed + count)));
+            consumed += count;
+        }
+
+        publish(std::move(blocks), size + values.size(), old_snapshot->version() + 1);
+    }
+
+private:
+    static std::shared_ptr<const Block> make_block(std::vector<T>&& values) {
+        T max = values.empty() ? std::numeric_limits<T>::lowest() : *std::max_element(values.begin(), values.end());
+        return std::make_shared<const Block>(Block{std::move(values), max});
+    }
+
+    /**
+     * Список блоков снимка - основа новой версии (сами блоки не копируются)
+     */
+    static std::vector<std::shared_ptr<const Block>> blocks_of(const Snapshot& snapshot) {
+        std::vector<std::shared_ptr<const Block>> blocks;
+        blocks.reserve(snapshot.blocks_.size() + 1);
+        blocks.assign(snapshot.blocks_.begin(), snapshot.blocks_.end());
+        return blocks;
+    }
+
+    void publish(std::vector<std::shared_ptr<const Block>>&& blocks, std::size_t size, std::uint64_t version) {
+        current_.store(std::make_shared<const Snapshot>(std::move(blocks), size, block_size_, version),
+                       std::memory_order_release);
+    }
+
+private:
+    std::size_t block_size_;
+    std::atomic<std::shared_ptr<const Snapshot>> current_;
+    std::mutex writer_mutex_;
+};
+
+/**
+ * Параллельный поиск по снимку на постоянном пуле потоков
+ * Блоки снимка делятся между задачами пула (split_into_chunks), общий минимальный индекс - CAS-min,
+ * как в PoolParallelSolver; задача прекращает поиск, если другая уже нашла элемент левее её текущего блока
+ */
+template<typename T>
+class SnapshotSolver {
+public:
+    /**
+     * Конструктор
+     * @param num_threads количество потоков пула (опционально, если не указано - используется значение hardware_concurrency)
+     */
+    explicit SnapshotSolver(std::optional<int> num_threads = std::nullopt) {
+        std::size_t threads;
+        if (num_threads.has_value()) {
+            threads = static_cast<std::size_t>(std::max(num_threads.value(), 1));
+        } else {
+            auto hc = std::thread::hardware_concurrency();
+            threads = hc == 0 ? 2 : hc; // fallback на случай, если hardware_concurrency не работает
+        }
+        pool_ = std::make_unique<ThreadPool>(threads);
+    }
+
+    /**
+     * Индекс первого элемента снимка больше порога, или snapshot.size(), если такого нет
+     */
+    std::size_t first_index(const ArraySnapshot<T>& snapshot, T threshold) {
+        std::size_t blocks = snapshot.block_count();
+        if (blocks == 0) {
+            return snapshot.size();
+        }
+        std::size_t num_tasks = std::min(pool_->size(), blocks);
+        if (num_tasks == 1) {
+            return snapshot.find_first_greater(threshold);
+        }
+
+        // Свой минимальный индекс на вызов: решатель можно вызывать из нескольких потоков-читателей сразу
+        auto min_index = std::make_shared<std::atomic<std::size_t>>(snapshot.size());
+        std::vector<std::future<void>> futures;
+        futures.reserve(num_tasks);
+        for (const ChunkRange& chunk : split_into_chunks(blocks, num_tasks)) {
+            auto promise = std::make_shared<std::promise<void>>();
+            futures.push_back(promise->get_future());
+            pool_->submit([&snapshot, threshold, chunk, min_index, promise] {
+                for (std::size_t b = chunk.begin; b < chunk.end; b++) {
+                    // Другая задача уже нашла элемент левее этого блока
+                    if (min_index->load(std::memory_order_relaxed) < b * snapshot.block_size()) {
+                        break;
+                    }
+                    std::size_t index = snapshot.find_first_greater(threshold, b, b + 1);
+                    if (index != snapshot.size()) {
+                        std::size_t current = min_index->load(std::memory_order_relaxed);
+                        while (index < current &&
+                               !min_index->compare_exchange_weak(current, index, std::memory_order_relaxed)) {
+                            // current обновлён compare_exchange_weak - пробуем снова
+                        }
+                        break;
+                    }
+                }
+                promise->set_value();
+            });
+        }
+        for (auto& future : futures) {
+            future.get();
+        }
+        return min_index->load(std::memory_order_relaxed);
+    }
+
+    /**
+     * Первый элемент снимка больше порога
+     */
+    std::optional<T> solve(const ArraySnapshot<T>& snapshot, T threshold) {
+        std::size_t index = first_index(snapshot, threshold);
+        if (index == snapshot.size()) {
+            return std::nullopt;
+        }
+        return snapshot[index];
+    }
+
+    /**
+     * Поиск по текущей версии массива: снимок берётся один раз и живёт до конца поиска
+     */
+    std::optional<T> solve(const VersionedArray<T>& array, T threshold) {
+        auto snapshot = array.snapshot();
+        return solve(*snapshot, threshold);
+    }
+
+    std::string get_name() const {
+        return "Параллельный поиск по снимку (пул потоков, " + std::to_string(pool_->size()) + " потоков)";
+    }
+
+private:
+    std::unique_ptr<ThreadPool> pool_;
+};
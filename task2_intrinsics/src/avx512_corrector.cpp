@@ -0,0 +1,42 @@
+#include "avx512_corrector.hpp"
+#include <immintrin.h>
+
+void AVX512Corrector::apply(const Image& input, Image& output, float red_mult, float green_mult, float blue_mult) {
+    const int size = input.size();
+    
+    // 48 values = 16 full pixels = 3 vectors of 16 floats
+    // coefficient pattern of vector k starts with channel (16 * k) % 3
+    alignas(64) float pattern[48];
+    for (int j = 0; j < 48; j += 3) {
+        pattern[j + 0] = red_mult;
+        pattern[j + 1] = green_mult;
+        pattern[j + 2] = blue_mult;
+    }
+    __m512 color_multipliers = _mm512_load_ps(&pattern[0]);
+    __m512 color_multipliers_shift = _mm512_load_ps(&pattern[16]);
+    __m512 color_multipliers_shift2 = _mm512_load_ps(&pattern[32]);
+    
+    int i = 0;
+    // process blocks of 48 values (16 full pixels)
+    // image data is only 32-byte aligned, so unaligned loads/stores are used
+    for (; i <= size - 48; i += 48) {
+        __m512 pixels1 = _mm512_loadu_ps(&input.data[i]);
+        __m512 pixels2 = _mm512_loadu_ps(&input.data[i + 16]);
+        __m512 pixels3 = _mm512_loadu_ps(&input.data[i + 32]);
+
+        _mm512_storeu_ps(&output.data[i], _mm512_mul_ps(pixels1, color_multipliers));
+        _mm512_storeu_ps(&output.data[i + 16], _mm512_mul_ps(pixels2, color_multipliers_shift));
+        _mm512_storeu_ps(&output.data[i + 32], _mm512_mul_ps(pixels3, color_multipliers_shift2));
+    }
+    
+    // process remainder (if size is not a multiple of 48)
+    for (; i < size; i += 3) {
+        output.data[i + 0] = input.data[i + 0] * red_mult;    // R
+        output.data[i + 1] = input.data[i + 1] * green_mult;  // G
+        output.data[i + 2] = input.data[i + 2] * blue_mult;   // B
+    }
+}
+
+std::string AVX512Corrector::get_name() const {
+    return "avx512";
+}
@@ -0,0 +1,11 @@
+#pragma once
+
+#include "base_color_corrector.hpp"
+
+// AVX-512 color corrector
+// Uses 512-bit AVX-512 instructions (16 floats per multiplication)
+class AVX512Corrector : public BaseColorCorrector {
+public:
+    void apply(const Image& input, Image& output, float red_mult, float green_mult, float blue_mult) override;
+    std::string get_name() const override;
+};
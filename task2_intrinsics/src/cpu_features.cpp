@@ -0,0 +1,18 @@
+#include "cpu_features.hpp"
+
+static CpuFeatures detect_cpu_features() {
+    CpuFeatures features;
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+    __builtin_cpu_init();
+    features.sse42 = __builtin_cpu_supports("sse4.2");
+    features.avx2 = __builtin_cpu_supports("avx2");
+    features.avx512f = __builtin_cpu_supports("avx512f");
+#endif
+    return features;
+}
+
+const CpuFeatures& cpu_features() {
+    // thread-safe one-time initialization
+    static const CpuFeatures features = detect_cpu_features();
+    return features;
+}
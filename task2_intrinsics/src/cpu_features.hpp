@@ -0,0 +1,16 @@
+#pragma once
+
+// SIMD instruction sets supported by the current CPU
+struct CpuFeatures {
+    bool sse42 = false;
+    bool avx2 = false;
+    bool avx512f = false;
+};
+
+/**
+ * Get SIMD instruction sets supported by the current CPU.
+ * CPUID is queried only once, on the first call.
+ * 
+ * @return Reference to the detected feature set
+ */
+const CpuFeatures& cpu_features();
@@ -0,0 +1,27 @@
+#include "dispatch_corrector.hpp"
+#include "cpu_features.hpp"
+#include "sequential_corrector.hpp"
+#include "sse_corrector.hpp"
+#include "avx_corrector.hpp"
+#include "avx512_corrector.hpp"
+
+DispatchCorrector::DispatchCorrector() {
+    const CpuFeatures& cpu = cpu_features();
+    if (cpu.avx512f) {
+        impl_ = std::make_unique<AVX512Corrector>();
+    } else if (cpu.avx2) {
+        impl_ = std::make_unique<AVXCorrector>();
+    } else if (cpu.sse42) {
+        impl_ = std::make_unique<SSECorrector>();
+    } else {
+        impl_ = std::make_unique<SequentialCorrector>();
+    }
+}
+
+void DispatchCorrector::apply(const Image& input, Image& output, float red_mult, float green_mult, float blue_mult) {
+    impl_->apply(input, output, red_mult, green_mult, blue_mult);
+}
+
+std::string DispatchCorrector::get_name() const {
+    return "dispatch_" + impl_->get_name();
+}
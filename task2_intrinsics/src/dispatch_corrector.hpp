@@ -0,0 +1,19 @@
+#pragma once
+
+#include "base_color_corrector.hpp"
+
+#include <memory>
+
+// Dispatching color corrector
+// Checks CPU features once (at construction) and forwards to the fastest supported
+// implementation: AVX-512, AVX2, SSE4.2 or sequential
+class DispatchCorrector : public BaseColorCorrector {
+public:
+    DispatchCorrector();
+
+    void apply(const Image& input, Image& output, float red_mult, float green_mult, float blue_mult) override;
+    std::string get_name() const override;
+
+private:
+    std::unique_ptr<BaseColorCorrector> impl_;
+};
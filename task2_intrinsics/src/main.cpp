@@ -4,7 +4,11 @@
 #include "image.hpp"
 #include "base_color_corrector.hpp"
 #include "sequential_corrector.hpp"
+#include "sse_corrector.hpp"
 #include "avx_corrector.hpp"
+#include "avx512_corrector.hpp"
+#include "dispatch_corrector.hpp"
+#include "cpu_features.hpp"
 
 /**
  * Extract filename without extension from a path.
@@ -88,10 +92,40 @@ int main(int argc, char* argv[]) {
         RED_MULTIPLIER, GREEN_MULTIPLIER, BLUE_MULTIPLIER,
         input_name
     );
+    // SIMD implementations are run only if the CPU supports them
+    // (otherwise they would crash with an illegal instruction)
+    const CpuFeatures& cpu = cpu_features();
+    // test SSE implementation
+    if (cpu.sse42) {
+        SSECorrector sse_corrector;
+        test_corrector(
+            sse_corrector, *input,
+            RED_MULTIPLIER, GREEN_MULTIPLIER, BLUE_MULTIPLIER,
+            input_name
+        );
+    }
     // test AVX implementation
-    AVXCorrector avx_corrector;
+    if (cpu.avx2) {
+        AVXCorrector avx_corrector;
+        test_corrector(
+            avx_corrector, *input,
+            RED_MULTIPLIER, GREEN_MULTIPLIER, BLUE_MULTIPLIER,
+            input_name
+        );
+    }
+    // test AVX-512 implementation
+    if (cpu.avx512f) {
+        AVX512Corrector avx512_corrector;
+        test_corrector(
+            avx512_corrector, *input,
+            RED_MULTIPLIER, GREEN_MULTIPLIER, BLUE_MULTIPLIER,
+            input_name
+        );
+    }
+    // test runtime-dispatched implementation (best one for this CPU)
+    DispatchCorrector dispatch_corrector;
     test_corrector(
-        avx_corrector, *input,
+        dispatch_corrector, *input,
         RED_MULTIPLIER, GREEN_MULTIPLIER, BLUE_MULTIPLIER,
         input_name
     );
@@ -0,0 +1,35 @@
+#include "sse_corrector.hpp"
+#include <immintrin.h>
+
+void SSECorrector::apply(const Image& input, Image& output, float red_mult, float green_mult, float blue_mult) {
+    const int size = input.size();
+    
+    // create vector of coefficients for 4 values
+    // pattern: R G B R | G B R G | B R G B (4 full pixels in 3 vectors)
+    __m128 color_multipliers = _mm_setr_ps(red_mult, green_mult, blue_mult, red_mult);
+    __m128 color_multipliers_shift = _mm_setr_ps(green_mult, blue_mult, red_mult, green_mult);
+    __m128 color_multipliers_shift2 = _mm_setr_ps(blue_mult, red_mult, green_mult, blue_mult);
+    
+    int i = 0;
+    // process blocks of 12 values (4 full pixels)
+    for (; i <= size - 12; i += 12) {
+        __m128 pixels1 = _mm_load_ps(&input.data[i]);
+        __m128 pixels2 = _mm_load_ps(&input.data[i + 4]);
+        __m128 pixels3 = _mm_load_ps(&input.data[i + 8]);
+
+        _mm_store_ps(&output.data[i], _mm_mul_ps(pixels1, color_multipliers));
+        _mm_store_ps(&output.data[i + 4], _mm_mul_ps(pixels2, color_multipliers_shift));
+        _mm_store_ps(&output.data[i + 8], _mm_mul_ps(pixels3, color_multipliers_shift2));
+    }
+    
+    // process remainder (if size is not a multiple of 12)
+    for (; i < size; i += 3) {
+        output.data[i + 0] = input.data[i + 0] * red_mult;    // R
+        output.data[i + 1] = input.data[i + 1] * green_mult;  // G
+        output.data[i + 2] = input.data[i + 2] * blue_mult;   // B
+    }
+}
+
+std::string SSECorrector::get_name() const {
+    return "sse";
+}
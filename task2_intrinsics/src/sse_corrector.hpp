@@ -0,0 +1,11 @@
+#pragma once
+
+#include "base_color_corrector.hpp"
+
+// SSE color corrector
+// Uses 128-bit SSE instructions (4 floats per multiplication) for CPUs without AVX
+class SSECorrector : public BaseColorCorrector {
+public:
+    void apply(const Image& input, Image& output, float red_mult, float green_mult, float blue_mult) override;
+    std::string get_name() const override;
+};
@@ -0,0 +1,257 @@
+#pragma once
+
+#include "base_solver.hpp"
+#include "early_exit_solver.hpp"
+#include "simd_search.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <limits>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include <omp.h>
+
+
+/**
+ * Адаптивная реализация задачи: на каждый вызов сама выбирает последовательный проход,
+ * векторный (SIMD) проход или поиск на N потоках по модели стоимости
+ *
+ * На малых массивах параллельные решатели медленнее последовательного: fork/join команды потоков OpenMP
+ * стоит дороже самого поиска. Здесь один раз, при создании, измеряются:
+ *   - стоимость просмотра одного элемента скалярным циклом и ядром find_first_greater (нс/элемент)
+ *   - накладные расходы параллельной области из k потоков (нс) и стоимость элемента на k потоках, для нескольких k
+ *
+ * На каждый вызов:
+ *   - сначала последовательно (SIMD) просматривается короткий префикс - столько элементов,
+ *     сколько можно просмотреть за время самого дешёвого запуска потоков; если ответ в нём - потоки не нужны
+ *   - для остатка оценивается ожидаемая позиция совпадения (скользящее среднее по предыдущим вызовам,
+ *     либо подсказка expect_match_at) и выбирается вариант с наименьшей оценкой времени:
+ *       последовательно:  ожидаемая_длина * стоимость_элемента
+ *       k потоков:        накладные_расходы(k) + ожидаемая_длина * стоимость_элемента(k)
+ *     (потоки идут по массиву вместе блоками EarlyExitSolver, поэтому совпадение на позиции p находится примерно за p / k;
+ *     стоимость_элемента(k) измеряется на k потоках сразу, так что учитывается реальное, а не идеальное ускорение)
+ */
+template<typename T>
+class AdaptiveSolver : public BaseSolver<T> {
+public:
+    // Что выбрано для очередного вызова
+    enum class Strategy {
+        Sequential,
+        Simd,
+        Threads,
+    };
+
+    /**
+     * Конструктор: калибрует модель стоимости
+     * @param num_threads наибольшее число потоков (опционально, если не указано - используется дефолтное значение OpenMP)
+     */
+    explicit AdaptiveSolver(std::optional<int> num_threads = std::nullopt)
+        : max_threads_(num_threads.has_value() ? std::max(num_threads.value(), 1) : omp_get_max_threads()) {
+        calibrate();
+    }
+
+    std::optional<T> solve(std::span<const T> arr, T threshold) override {
+        std::size_t index = first_index(arr, threshold);
+        record_match(index, arr.size());
+
+        // Элемент, больший порога, не найден
+        if (index == arr.size()) {
+            return std::nullopt;
+        }
+
+        return arr[index];
+    }
+
+    /**
+     * Подсказка: где ожидать первое совпадение (доля размера массива, 1 - совпадений, скорее всего, нет)
+     * Дальше оценка уточняется по результатам вызовов
+     */
+    void expect_match_at(double fraction) {
+        expected_fraction_ = std::clamp(fraction, 0.0, 1.0);
+    }
+
+    Strategy last_strategy() const {
+        return last_strategy_;
+    }
+
+    /**
+     * Число потоков, выбранное в последнем вызове (1 для последовательных вариантов)
+     */
+    std::size_t last_threads() const {
+        return last_threads_;
+    }
+
+    /**
+     * Длина префикса, просматриваемого последовательно перед запуском потоков
+     */
+    std::size_t prefix_length() const {
+        return prefix_length_;
+    }
+
+    std::string get_name() const override {
+        return "Адаптивная версия (до " + std::to_string(max_threads_) + " потоков, префикс "
+               + std::to_string(prefix_length_) + " элементов)";
+    }
+
+private:
+    // Сколько элементов в буфере для калибровки стоимости просмотра (2 МБ для long long)
+    static constexpr std::size_t kCalibrationSize = 1 << 18;
+    // Сколько раз повторяется каждое измерение (берётся лучший результат)
+    static constexpr int kCalibrationRuns = 5;
+    // Границы длины последовательного префикса
+    static constexpr std::size_t kMinPrefix = 1024;
+    static constexpr std::size_t kMaxPrefix = 1 << 20;
+    // Вес нового наблюдения в скользящем среднем позиции совпадения
+    static constexpr double kMatchSmoothing = 0.25;
+
+    struct ThreadCost {
+        std::size_t threads;
+        // Параллельная область без работы
+        double overhead_ns;
+        // Время на элемент массива при просмотре k потоками (с учётом того, что ядра и память общие)
+        double ns_per_element;
+    };
+
+    std::size_t first_index(std::span<const T> arr, T threshold) {
+        std::size_t n = arr.size();
+
+        // Префикс: даже если дальше пойдём в потоки, сначала дёшево проверяем начало массива
+        std::size_t prefix = std::min(n, prefix_length_);
+        std::size_t index = scan_sequential(arr.data(), prefix, threshold);
+        if (index != prefix || prefix == n) {
+            return index;
+        }
+
+        std::size_t rest = n - prefix;
+        double expected = std::max(expected_fraction_ * static_cast<double>(n) - static_cast<double>(prefix), 1.0);
+        expected = std::min(expected, static_cast<double>(rest));
+
+        double best_cost = expected * sequential_cost_ns();
+        std::size_t best_threads = 1;
+        for (const auto& cost : thread_costs_) {
+            double estimate = cost.overhead_ns + expected * cost.ns_per_element;
+            if (estimate < best_cost) {
+                best_cost = estimate;
+                best_threads = cost.threads;
+            }
+        }
+
+        if (best_threads == 1) {
+            return prefix + scan_sequential(arr.data() + prefix, rest, threshold);
+        }
+        last_strategy_ = Strategy::Threads;
+        last_threads_ = best_threads;
+        return prefix + parallel_solver_.first_index(arr.subspan(prefix), threshold, static_cast<int>(best_threads));
+    }
+
+    /**
+     * Последовательный проход более дешёвым (по калибровке) из двух способов
+     */
+    std::size_t scan_sequential(const T* data, std::size_t n, T threshold) {
+        last_threads_ = 1;
+        if (scalar_ns_per_element_ < simd_ns_per_element_) {
+            last_strategy_ = Strategy::Sequential;
+            return scan_scalar(data, n, threshold);
+        }
+        last_strategy_ = Strategy::Simd;
+        return find_first_greater(data, n, threshold);
+    }
+
+    static std::size_t scan_scalar(const T* data, std::size_t n, T threshold) {
+        for (std::size_t i = 0; i < n; i++) {
+            if (data[i] > threshold) {
+                return i;
+            }
+        }
+        return n;
+    }
+
+    double sequential_cost_ns() const {
+        return std::min(scalar_ns_per_element_, simd_ns_per_element_);
+    }
+
+    /**
+     * Обновить скользящее среднее позиции первого совпадения (доля от размера массива)
+     */
+    void record_match(std::size_t index, std::size_t n) {
+        if (n == 0) {
+            return;
+        }
+        double fraction = static_cast<double>(std::min(index + 1, n)) / static_cast<double>(n);
+        expected_fraction_ += kMatchSmoothing * (fraction - expected_fraction_);
+    }
+
+    /**
+     * Лучшее из kCalibrationRuns время выполнения func, в наносекундах
+     */
+    template<typename Func>
+    static double measure_ns(Func func) {
+        using clock = std::chrono::steady_clock;
+        double best = std::numeric_limits<double>::max();
+        for (int run = 0; run < kCalibrationRuns; run++) {
+            auto start = clock::now();
+            func();
+            best = std::min(best, std::chrono::duration<double, std::nano>(clock::now() - start).count());
+        }
+        return best;
+    }
+
+    void calibrate() {
+        // Буфер без подходящих элементов - просматривается целиком
+        std::vector<T> buffer(kCalibrationSize, T{});
+        T threshold = T{};
+        volatile std::size_t sink = 0;
+
+        scalar_ns_per_element_ = measure_ns([&] { sink = scan_scalar(buffer.data(), buffer.size(), threshold); })
+                                 / kCalibrationSize;
+        simd_ns_per_element_ = measure_ns([&] { sink = find_first_greater(buffer.data(), buffer.size(), threshold); })
+                               / kCalibrationSize;
+
+        // Накладные расходы: один блок на k потоков - время почти целиком уходит на fork/join
+        std::size_t max_threads = static_cast<std::size_t>(max_threads_);
+        std::span<const T> tiny(buffer.data(), 1);
+        std::vector<std::size_t> candidates;
+        for (std::size_t k = 2; k < max_threads; k *= 2) {
+            candidates.push_back(k);
+        }
+        if (max_threads >= 2) {
+            candidates.push_back(max_threads);
+        }
+        for (std::size_t k : candidates) {
+            int threads = static_cast<int>(k);
+            double overhead = measure_ns([&] { sink = parallel_solver_.first_index(tiny, threshold, threads); });
+            // Полный буфер на k потоках: реальное ускорение, а не идеальное k-кратное
+            // (на занятой машине или при упоре в память оно заметно меньше).
+            // Накладные расходы из этого времени не вычитаются: оценка получается с запасом в пользу последовательного прохода
+            double full = measure_ns([&] { sink = parallel_solver_.first_index(buffer, threshold, threads); });
+            thread_costs_.push_back({k, overhead, full / kCalibrationSize});
+        }
+        (void)sink;
+
+        // Префикс стоит столько же, сколько самый дешёвый запуск потоков
+        double cheapest = std::numeric_limits<double>::max();
+        for (const auto& cost : thread_costs_) {
+            cheapest = std::min(cheapest, cost.overhead_ns);
+        }
+        if (thread_costs_.empty()) {
+            prefix_length_ = kMaxPrefix;
+        } else {
+            double length = cheapest / std::max(sequential_cost_ns(), 1e-3);
+            prefix_length_ = std::clamp(static_cast<std::size_t>(length), kMinPrefix, kMaxPrefix);
+        }
+    }
+
+private:
+    int max_threads_;
+    EarlyExitSolver<T> parallel_solver_;
+    double scalar_ns_per_element_ = 0;
+    double simd_ns_per_element_ = 0;
+    std::vector<ThreadCost> thread_costs_;
+    std::size_t prefix_length_ = kMinPrefix;
+    // Ожидаемая позиция первого совпадения (доля массива); 1 - просматривать до конца
+    double expected_fraction_ = 1.0;
+    Strategy last_strategy_ = Strategy::Simd;
+    std::size_t last_threads_ = 1;
+};
@@ -1,6 +1,9 @@
 #pragma once
 
+#include "multi_threshold.hpp"
+
 #include <optional>
+#include <span>
 #include <string>
 #include <vector>
 
@@ -25,7 +28,23 @@ public:
      * @param threshold заранее заданное пороговое значение
      * @return std::nullopt, если число не найдено; иначе первое число, превышающее threshold
      */
-    virtual std::optional<T> solve(const std::vector<T>& arr, T threshold) = 0;
+    virtual std::optional<T> solve(std::span<const T> arr, T threshold) = 0;
+
+    /**
+     * Решить задачу сразу для нескольких порогов за один проход по массиву
+     * Пороги сортируются, и каждый "гасится", как только найден элемент больше него
+     * Базовая реализация - однопоточная, параллельные решатели могут её переопределить
+     *
+     * @param arr массив чисел для поиска
+     * @param thresholds пороговые значения (в любом порядке, допускаются повторы)
+     * @return для каждого порога (в порядке thresholds) первое число, превышающее его, или std::nullopt
+     */
+    virtual std::vector<std::optional<T>> solve_many(std::span<const T> arr, std::span<const T> thresholds) {
+        SortedThresholds<T> sorted = sort_thresholds(thresholds);
+        std::vector<std::vector<std::size_t>> chunk_results;
+        chunk_results.push_back(scan_many(arr.data(), 0, arr.size(), sorted.values));
+        return merge_many(arr.data(), sorted, chunk_results);
+    }
     
     /**
      * Получить имя реализации (последовательная или параллельная)
@@ -0,0 +1,418 @@
+#include "sequential_solver.hpp"
+#include "parallel_solver.hpp"
+#include "early_exit_solver.hpp"
+#include "taskloop_solver.hpp"
+#include "adaptive_solver.hpp"
+#include "simd_solver.hpp"
+#include "workload.hpp"
+
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <optional>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <omp.h>
+
+/**
+ * Бенчмарк решателей задачи "Найти первое число, превышающее заранее заданное"
+ *
+ * Перебирает размер массива, позицию первого совпадения, число потоков и реализацию;
+ * для каждой комбинации делает прогрев, затем повторы, и печатает медиану, p99
+ * и достигнутую пропускную способность (ГБ/с) в сравнении с измеренной пропускной способностью памяти
+ * (STREAM-подобные ядра read и triad). Результаты можно сохранить в JSON для сравнения между сборками
+ */
+
+namespace {
+
+constexpr long long kThreshold = 5000000;
+
+struct BenchmarkConfig {
+    std::vector<std::size_t> sizes = {1000000, 10000000};
+    // std::nullopt - совпадений нет (полный проход)
+    std::vector<std::optional<double>> positions = {0.0, 0.5, std::nullopt};
+    std::vector<int> threads = {1, 2, 4};
+    std::vector<std::string> solvers = {"sequential", "simd", "reduction", "early", "taskloop", "adaptive"};
+    int warmup = 2;
+    int repeats = 10;
+    std::size_t stream_size = 8000000;
+    std::uint64_t seed = 42;
+    std::size_t grainsize = 16384;
+    std::string json_path;
+};
+
+struct BenchmarkResult {
+    std::string solver;
+    std::string solver_name;
+    int threads = 1;
+    std::size_t size = 0;
+    std::optional<double> position;
+    double median_us = 0;
+    double p99_us = 0;
+    double min_us = 0;
+    double gbps = 0;
+    bool correct = true;
+};
+
+struct StreamResult {
+    double read_gbps = 0;
+    double triad_gbps = 0;
+};
+
+void print_usage(const char* prog_name) {
+    std::cout << "Использование: " << prog_name << " [опции]" << std::endl;
+    std::string usage = R"(
+Бенчмарк решателей: перебор размеров массива, позиций первого совпадения, числа потоков и реализаций
+Опции (списки - через запятую):
+  --sizes N1,N2,...             - размеры массива (по умолчанию 1000000,10000000)
+  --positions P1,P2,...         - позиции первого совпадения как доля размера, none - совпадений нет (по умолчанию 0,0.5,none)
+  --threads T1,T2,...           - число потоков для параллельных реализаций (по умолчанию 1,2,4)
+  --solvers S1,S2,...           - реализации: sequential, simd, reduction, early, taskloop, adaptive (по умолчанию все)
+  --warmup N                    - число прогревочных запусков (по умолчанию 2)
+  --repeats N                   - число измеряемых запусков (по умолчанию 10)
+  --stream-size N               - размер массивов для измерения пропускной способности памяти (по умолчанию 8000000)
+  --seed N                      - зерно генератора данных (по умолчанию 42)
+  --grainsize N                 - число элементов на задачу для taskloop (по умолчанию 16384)
+  --json файл                   - сохранить результаты в JSON
+)";
+    std::cout << usage << std::endl;
+}
+
+std::vector<std::string> split(const std::string& list) {
+    std::vector<std::string> items;
+    std::stringstream ss(list);
+    std::string item;
+    while (std::getline(ss, item, ',')) {
+        if (!item.empty()) {
+            items.push_back(item);
+        }
+    }
+    return items;
+}
+
+/**
+ * Решатели, для которых число потоков не имеет смысла - меряются один раз
+ */
+bool is_single_threaded(const std::string& solver) {
+    return solver == "sequential" || solver == "simd";
+}
+
+std::unique_ptr<BaseSolver<long long>> make_solver(const std::string& solver, int threads, std::size_t grainsize) {
+    if (solver == "sequential") {
+        return std::make_unique<SequentialSolver<long long>>();
+    }
+    if (solver == "simd") {
+        return std::make_unique<SimdSolver>();
+    }
+    if (solver == "reduction") {
+        return std::make_unique<ParallelSolver<long long>>(threads);
+    }
+    if (solver == "early") {
+        return std::make_unique<EarlyExitSolver<long long>>(threads);
+    }
+    if (solver == "taskloop") {
+        return std::make_unique<TaskloopSolver<long long>>(threads, grainsize);
+    }
+    if (solver == "adaptive") {
+        return std::make_unique<AdaptiveSolver<long long>>(threads);
+    }
+    return nullptr;
+}
+
+/**
+ * Выполнить func(part) для part = 0..num_parts-1 в команде OpenMP из num_parts потоков
+ */
+template<typename Func>
+void run_parallel(int num_parts, Func func) {
+    #pragma omp parallel num_threads(num_parts)
+    {
+        func(omp_get_thread_num());
+    }
+}
+
+/**
+ * STREAM-подобное измерение пропускной способности памяти на num_threads потоках:
+ *   read  - сумма элементов массива (8 байт чтения на элемент), ближе всего к профилю поиска
+ *   triad - a[i] = b[i] + s * c[i] (24 байта на элемент)
+ * Как и в STREAM, берётся лучший из нескольких запусков
+ */
+StreamResult measure_stream(std::size_t size, int num_threads) {
+    using clock = std::chrono::steady_clock;
+    constexpr int kRuns = 5;
+
+    auto a = std::make_unique_for_overwrite<long long[]>(size);
+    auto b = std::make_unique_for_overwrite<long long[]>(size);
+    auto c = std::make_unique_for_overwrite<long long[]>(size);
+    fill_parallel(std::span<long long>(a.get(), size), [](std::size_t i) { return static_cast<long long>(i); }, num_threads);
+    fill_parallel(std::span<long long>(b.get(), size), [](std::size_t i) { return static_cast<long long>(i) * 2; }, num_threads);
+    fill_parallel(std::span<long long>(c.get(), size), [](std::size_t i) { return static_cast<long long>(i) * 3; }, num_threads);
+
+    auto part_begin = [&](int part) { return size * part / num_threads; };
+
+    StreamResult result;
+    std::vector<long long> sums(num_threads);
+    for (int run = 0; run < kRuns; run++) {
+        auto start = clock::now();
+        run_parallel(num_threads, [&](int part) {
+            // Несколько независимых сумм, чтобы измерять память, а не цепочку зависимых сложений
+            long long s0 = 0, s1 = 0, s2 = 0, s3 = 0;
+            std::size_t i = part_begin(part);
+            std::size_t end = part_begin(part + 1);
+            for (; i + 4 <= end; i += 4) {
+                s0 += a[i];
+                s1 += a[i + 1];
+                s2 += a[i + 2];
+                s3 += a[i + 3];
+            }
+            for (; i < end; i++) {
+                s0 += a[i];
+            }
+            sums[part] = s0 + s1 + s2 + s3;
+        });
+        double seconds = std::chrono::duration<double>(clock::now() - start).count();
+        result.read_gbps = std::max(result.read_gbps, size * sizeof(long long) / seconds / 1e9);
+
+        start = clock::now();
+        run_parallel(num_threads, [&](int part) {
+            for (std::size_t i = part_begin(part); i < part_begin(part + 1); i++) {
+                a[i] = b[i] + 3 * c[i];
+            }
+        });
+        seconds = std::chrono::duration<double>(clock::now() - start).count();
+        result.triad_gbps = std::max(result.triad_gbps, 3 * size * sizeof(long long) / seconds / 1e9);
+    }
+
+    // Не даём компилятору выбросить чтение как неиспользуемое
+    volatile long long sink = 0;
+    for (long long sum : sums) {
+        sink = sink + sum;
+    }
+    (void)sink;
+    return result;
+}
+
+/**
+ * Перцентиль по методу ближайшего ранга; values должны быть отсортированы
+ */
+double percentile(const std::vector<double>& values, double p) {
+    std::size_t rank = static_cast<std::size_t>(std::ceil(p * values.size()));
+    return values[std::min(values.size() - 1, rank == 0 ? 0 : rank - 1)];
+}
+
+std::string position_to_string(const std::optional<double>& position) {
+    if (!position.has_value()) {
+        return "none";
+    }
+    std::ostringstream out;
+    out << position.value();
+    return out.str();
+}
+
+std::string json_escape(const std::string& text) {
+    std::string escaped;
+    for (char ch : text) {
+        if (ch == '"' || ch == '\\') {
+            escaped += '\\';
+        }
+        escaped += ch;
+    }
+    return escaped;
+}
+
+bool write_json(const std::string& path, const StreamResult& stream, const std::vector<BenchmarkResult>& results) {
+    std::ofstream out(path);
+    if (!out) {
+        return false;
+    }
+    out << "{\n";
+    out << "  \"stream\": {\"read_gbps\": " << stream.read_gbps << ", \"triad_gbps\": " << stream.triad_gbps << "},\n";
+    out << "  \"results\": [\n";
+    for (std::size_t i = 0; i < results.size(); i++) {
+        const auto& r = results[i];
+        out << "    {\"solver\": \"" << r.solver << "\""
+            << ", \"solver_name\": \"" << json_escape(r.solver_name) << "\""
+            << ", \"threads\": " << r.threads
+            << ", \"size\": " << r.size
+            << ", \"match_position\": " << (r.position.has_value() ? position_to_string(r.position) : "null")
+            << ", \"median_us\": " << r.median_us
+            << ", \"p99_us\": " << r.p99_us
+            << ", \"min_us\": " << r.min_us
+            << ", \"gbps\": " << r.gbps
+            << ", \"stream_fraction\": " << (stream.read_gbps > 0 ? r.gbps / stream.read_gbps : 0)
+            << ", \"correct\": " << (r.correct ? "true" : "false")
+            << "}" << (i + 1 < results.size() ? "," : "") << "\n";
+    }
+    out << "  ]\n";
+    out << "}\n";
+    return static_cast<bool>(out);
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    BenchmarkConfig config;
+
+    // Обработка аргументов командной строки
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "-h" || arg == "--help") {
+            print_usage(argv[0]);
+            return 0;
+        }
+        if (i + 1 >= argc) {
+            std::cerr << "Ошибка: неизвестный аргумент или нет значения: " << arg << std::endl;
+            print_usage(argv[0]);
+            return 1;
+        }
+        std::string value = argv[++i];
+        if (arg == "--sizes") {
+            config.sizes.clear();
+            for (const auto& item : split(value)) {
+                config.sizes.push_back(std::strtoull(item.c_str(), nullptr, 10));
+            }
+        } else if (arg == "--positions") {
+            config.positions.clear();
+            for (const auto& item : split(value)) {
+                config.positions.push_back(item == "none" ? std::nullopt : std::optional<double>(std::atof(item.c_str())));
+            }
+        } else if (arg == "--threads") {
+            config.threads.clear();
+            for (const auto& item : split(value)) {
+                config.threads.push_back(std::max(std::atoi(item.c_str()), 1));
+            }
+        } else if (arg == "--solvers") {
+            config.solvers = split(value);
+        } else if (arg == "--warmup") {
+            config.warmup = std::max(std::atoi(value.c_str()), 0);
+        } else if (arg == "--repeats") {
+            config.repeats = std::max(std::atoi(value.c_str()), 1);
+        } else if (arg == "--stream-size") {
+            config.stream_size = std::max<std::size_t>(std::strtoull(value.c_str(), nullptr, 10), 1);
+        } else if (arg == "--seed") {
+            config.seed = std::strtoull(value.c_str(), nullptr, 10);
+        } else if (arg == "--grainsize") {
+            config.grainsize = std::strtoull(value.c_str(), nullptr, 10);
+        } else if (arg == "--json") {
+            config.json_path = value;
+        } else {
+            std::cerr << "Ошибка: неизвестный аргумент " << arg << std::endl;
+            print_usage(argv[0]);
+            return 1;
+        }
+    }
+    for (const auto& solver : config.solvers) {
+        if (!make_solver(solver, 1, config.grainsize)) {
+            std::cerr << "Ошибка: неизвестная реализация " << solver << std::endl;
+            print_usage(argv[0]);
+            return 1;
+        }
+    }
+
+    if (config.threads.empty()) {
+        std::cerr << "Ошибка: список --threads пуст" << std::endl;
+        print_usage(argv[0]);
+        return 1;
+    }
+
+    int max_threads = *std::max_element(config.threads.begin(), config.threads.end());
+    StreamResult stream = measure_stream(config.stream_size, max_threads);
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << "Пропускная способность памяти (" << max_threads << " потоков): read "
+              << stream.read_gbps << " ГБ/с, triad " << stream.triad_gbps << " ГБ/с" << std::endl;
+    std::cout << "========================================" << std::endl;
+    std::cout << std::left
+              << std::setw(12) << "solver" << std::setw(9) << "threads" << std::setw(12) << "size"
+              << std::setw(10) << "position" << std::setw(14) << "median_us" << std::setw(14) << "p99_us"
+              << std::setw(10) << "GB/s" << std::setw(10) << "%read" << "ok" << std::endl;
+
+    using clock = std::chrono::steady_clock;
+    std::vector<BenchmarkResult> results;
+    bool all_correct = true;
+
+    for (std::size_t size : config.sizes) {
+        for (const auto& position : config.positions) {
+            WorkloadSpec<long long> workload;
+            workload.pattern = WorkloadPattern::Planted;
+            workload.threshold = kThreshold;
+            workload.match_position = position;
+            workload.seed = config.seed;
+            auto data = make_workload_array<long long>(size, workload, max_threads);
+            std::span<const long long> arr(data.get(), size);
+
+            std::size_t first_match = planted_index(workload, size);
+            std::optional<long long> expected = std::nullopt;
+            if (first_match < size) {
+                expected = arr[first_match];
+            }
+            // Сколько байт обязан прочитать идеальный поиск
+            double bytes = static_cast<double>(std::min(first_match + 1, size)) * sizeof(long long);
+
+            for (const auto& solver_key : config.solvers) {
+                std::vector<int> thread_counts = config.threads;
+                if (is_single_threaded(solver_key)) {
+                    thread_counts = {1};
+                }
+                for (int threads : thread_counts) {
+                    auto solver = make_solver(solver_key, threads, config.grainsize);
+
+                    bool correct = true;
+                    for (int run = 0; run < config.warmup; run++) {
+                        correct = correct && (solver->solve(arr, kThreshold) == expected);
+                    }
+                    std::vector<double> times;
+                    times.reserve(config.repeats);
+                    for (int run = 0; run < config.repeats; run++) {
+                        auto start = clock::now();
+                        auto result = solver->solve(arr, kThreshold);
+                        times.push_back(std::chrono::duration<double, std::micro>(clock::now() - start).count());
+                        correct = correct && (result == expected);
+                    }
+                    std::sort(times.begin(), times.end());
+
+                    BenchmarkResult r;
+                    r.solver = solver_key;
+                    r.solver_name = solver->get_name();
+                    r.threads = threads;
+                    r.size = size;
+                    r.position = position;
+                    r.median_us = percentile(times, 0.5);
+                    r.p99_us = percentile(times, 0.99);
+                    r.min_us = times.front();
+                    r.gbps = bytes / (r.median_us * 1e-6) / 1e9;
+                    r.correct = correct;
+                    all_correct = all_correct && correct;
+                    results.push_back(r);
+
+                    std::cout << std::setw(12) << r.solver << std::setw(9) << r.threads << std::setw(12) << r.size
+                              << std::setw(10) << position_to_string(r.position)
+                              << std::setw(14) << r.median_us << std::setw(14) << r.p99_us
+                              << std::setw(10) << r.gbps << std::setw(10) << 100.0 * r.gbps / stream.read_gbps
+                              << (r.correct ? "да" : "НЕТ") << std::endl;
+                }
+            }
+        }
+    }
+
+    if (!config.json_path.empty()) {
+        if (!write_json(config.json_path, stream, results)) {
+            std::cerr << "Ошибка: не удалось записать " << config.json_path << std::endl;
+            return 1;
+        }
+        std::cout << "Результаты сохранены в " << config.json_path << std::endl;
+    }
+
+    if (!all_correct) {
+        std::cerr << "Ошибка: некоторые реализации вернули неверный результат" << std::endl;
+        return 1;
+    }
+    return 0;
+}
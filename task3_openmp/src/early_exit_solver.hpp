@@ -0,0 +1,139 @@
+#pragma once
+
+#include "base_solver.hpp"
+#include "simd_search.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <limits>
+#include <string>
+#include <vector>
+
+#include <omp.h>
+
+/**
+ * Параллельная реализация задачи с досрочным завершением (OpenMP)
+ *
+ * ParallelSolver с reduction(min:) всегда просматривает весь массив, даже если подходит элемент с индексом 0.
+ * Здесь потоки перестают работать, как только ответ найден:
+ *
+ * Суть:
+ *   - массив делится на блоки по chunk_size элементов, блоки раздаются через omp for schedule(dynamic, 1)
+ *   - найденный индекс публикуется в общий атомарный best_index циклом CAS-min
+ *   - блок, начинающийся правее best_index, пропускается без чтения
+ *   - если отмена включена (OMP_CANCELLATION=true), нашедший поток дополнительно выполняет
+ *     cancel for, и остальные потоки выходят из цикла в ближайшей cancellation point
+ *
+ * Отмена может прервать цикл до того, как будут просмотрены блоки левее найденного
+ * (порядок раздачи блоков стандартом не гарантируется), поэтому просмотренные блоки отмечаются,
+ * и после цикла непросмотренные блоки левее ответа досматриваются - результат всегда минимальный индекс
+ */
+template<typename T>
+class EarlyExitSolver : public BaseSolver<T> {
+public:
+    /**
+     * Конструктор
+     * @param num_threads количество потоков (опционально, если не указано - используется дефолтное значение OpenMP)
+     * @param chunk_size размер блока, выдаваемого потоку за один раз
+     */
+    explicit EarlyExitSolver(std::optional<int> num_threads = std::nullopt, std::size_t chunk_size = 4096)
+        : num_threads_(num_threads), chunk_size_(std::max<std::size_t>(chunk_size, 1)) {}
+
+private:
+    // Значение best_index, означающее "ничего не найдено"
+    static constexpr std::size_t kNotFound = std::numeric_limits<std::size_t>::max();
+
+public:
+    std::optional<T> solve(std::span<const T> arr, T threshold) override {
+        int threads = num_threads_.has_value() ? std::max(num_threads_.value(), 1) : omp_get_max_threads();
+        std::size_t index = first_index(arr, threshold, threads);
+
+        // Элемент, больший порога, не найден
+        if (index == arr.size()) {
+            return std::nullopt;
+        }
+
+        return arr[index];
+    }
+
+    /**
+     * Индекс первого элемента больше порога, или arr.size(), если такого нет
+     * В отличие от solve, число потоков задаётся на каждый вызов
+     */
+    std::size_t first_index(std::span<const T> arr, T threshold, int threads) {
+        if (arr.empty()) {
+            return 0;
+        }
+
+        const T* data = arr.data();
+        std::size_t n = arr.size();
+        std::size_t chunk_size = chunk_size_;
+        std::size_t num_chunks = (n + chunk_size - 1) / chunk_size;
+        threads = std::max(threads, 1);
+
+        std::atomic<std::size_t> best_index{kNotFound};
+        // scanned[c] != 0 - блок c просмотрен целиком (нужно только при отмене цикла)
+        std::vector<unsigned char> scanned(num_chunks, 0);
+
+        #pragma omp parallel num_threads(threads)
+        {
+            #pragma omp for schedule(dynamic, 1)
+            for (std::size_t c = 0; c < num_chunks; c++) {
+                #pragma omp cancellation point for
+
+                std::size_t begin = c * chunk_size;
+                // Блок целиком правее уже найденного элемента - читать его незачем
+                if (begin > best_index.load(std::memory_order_relaxed)) {
+                    continue;
+                }
+
+                std::size_t len = std::min(chunk_size, n - begin);
+                std::size_t offset = find_first_greater(data + begin, len, threshold);
+                scanned[c] = 1;
+                if (offset != len) {
+                    publish_min_index(best_index, begin + offset);
+                    #pragma omp cancel for
+                }
+            }
+        }
+
+        // После отмены досматриваем блоки левее ответа, до которых цикл не дошёл
+        std::size_t min_index = best_index.load(std::memory_order_relaxed);
+        for (std::size_t c = 0; min_index != kNotFound && c <= min_index / chunk_size; c++) {
+            if (scanned[c]) {
+                continue;
+            }
+            std::size_t begin = c * chunk_size;
+            std::size_t len = std::min(chunk_size, n - begin);
+            std::size_t offset = find_first_greater(data + begin, len, threshold);
+            if (offset != len) {
+                min_index = std::min(min_index, begin + offset);
+            }
+        }
+
+        return min_index == kNotFound ? n : min_index;
+    }
+
+    std::string get_name() const override {
+        std::string name = "Параллельная версия (OpenMP, досрочное завершение";
+        if (omp_get_cancellation()) {
+            name += ", omp cancel";
+        }
+        return name + ")";
+    }
+
+private:
+    /**
+     * Опубликовать найденный индекс: best_index = min(best_index, index) циклом CAS
+     */
+    static void publish_min_index(std::atomic<std::size_t>& best_index, std::size_t index) {
+        std::size_t current = best_index.load(std::memory_order_relaxed);
+        while (index < current &&
+               !best_index.compare_exchange_weak(current, index, std::memory_order_relaxed)) {
+        }
+    }
+
+private:
+    std::optional<int> num_threads_;
+    std::size_t chunk_size_;
+};
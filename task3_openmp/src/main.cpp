@@ -1,6 +1,15 @@
 #include "sequential_solver.hpp"
 #include "parallel_solver.hpp"
+#include "early_exit_solver.hpp"
+#include "taskloop_solver.hpp"
+#include "adaptive_solver.hpp"
+#include "simd_solver.hpp"
+#include "mapped_file.hpp"
+#include "query_server.hpp"
+#include "workload.hpp"
 
+#include <csignal>
+#include <cstdint>
 #include <cstdlib>
 
 #include <algorithm>
@@ -8,21 +17,61 @@
 #include <memory>
 #include <optional>
 #include <random>
+#include <span>
+#include <string>
 #include <vector>
 
 void print_usage(const char* prog_name) {
-    std::cout << "Использование: " << prog_name << " [количество_потоков]" << std::endl;
+    std::cout << "Использование: " << prog_name << " [количество_потоков] [реализация] [--input файл.bin] [--seed N]"
+              << " [--grainsize N] [--stats] [--pattern шаблон] [--match-pos доля|none] [--density доля]"
+              << " [--serve stdin|путь.sock] [--max-batch N]" << std::endl;
     std::string usage = R"(
 Программа находит первое число в массиве, превышающее заданное значение
-Массив заполняется случайными числами типа long long
+Массив заполняется случайными числами типа long long либо читается из бинарного файла
 Параметры:
   0                             - использовать последовательную версию
   N [положительное целое число] - использовать параллельную версию с N потоками
   не указано                    - использовать дефолтное количество потоков OpenMP
+Реализация:
+  reduction                     - parallel for + reduction(min:) (по умолчанию)
+  early                         - блоки через schedule(dynamic), досрочное завершение после первого найденного элемента
+                                  (с OMP_CANCELLATION=true дополнительно используется omp cancel for)
+  taskloop                      - задачи omp taskloop в порядке возрастания индекса, задачи правее найденного элемента отбрасываются
+  adaptive                      - на каждый вызов выбирает последовательный, SIMD или поиск на части потоков
+                                  по откалиброванной модели стоимости (N - наибольшее число потоков)
+  simd                          - однопоточный поиск на векторных инструкциях (число потоков игнорируется)
+Опции:
+  --input файл.bin              - искать в файле из 64-битных целых (отображается в память без копирования)
+  --seed N                      - зерно генератора случайного массива (по умолчанию случайное)
+  --grainsize N                 - примерное число элементов на одну задачу для taskloop (по умолчанию 16384)
+  --stats                       - дополнительно вывести количество элементов больше порога, максимум и его индекс
+                                  (один параллельный проход с пользовательской редукцией OpenMP)
+  --pattern шаблон              - как заполнять массив:
+                                    random      - случайные числа по всему диапазону (по умолчанию)
+                                    planted     - фон не больше порога, первое совпадение на заданной позиции
+                                    sorted      - возрастающая последовательность, пересекающая порог на заданной позиции
+                                    reverse     - убывающий фон не больше порога, совпадения как в planted
+                                    adversarial - фон ровно равен порогу, совпадения как в planted
+  --match-pos доля|none         - позиция первого совпадения как доля размера массива (по умолчанию 0.5), none - совпадений нет
+  --density доля                - доля совпадений среди элементов после первого (по умолчанию 0)
+  --serve stdin|путь.sock       - режим сервера: массив готовится один раз, затем пороги читаются построчно
+                                  из stdin (ответы - в stdout) или из Unix domain socket.
+                                  Строка запроса - один или несколько порогов через пробел, ответ - по числу на порог
+                                  или none. Все служебные сообщения идут в stderr. Остановка - конец ввода или SIGINT/SIGTERM
+  --max-batch N                 - наибольшее число порогов в одной микропорции сервера (по умолчанию 4096)
 )";
     std::cout << usage << std::endl;
 }
 
+// Сервер, которому обработчик SIGINT/SIGTERM передаёт просьбу остановиться
+QueryServer<long long>* g_server = nullptr;
+
+void handle_stop_signal(int) {
+    if (g_server != nullptr) {
+        g_server->request_stop();
+    }
+}
+
 void print_description() {
     std::string description = R"(
 Индивидуальный номер: 51
@@ -37,31 +86,129 @@ void print_description() {
 int main(int argc, char* argv[]) {
     // nullopt означает использовать дефолтное значение числа потоков для OpenMP
     std::optional<int> num_threads = std::nullopt;
+    std::string implementation = "reduction";
+
+    // путь к бинарному файлу с данными; пустая строка - массив генерируется случайно
+    std::string input_path;
+    // зерно генератора; nullopt - взять из std::random_device
+    std::optional<std::uint64_t> seed = std::nullopt;
+    // число элементов на задачу для taskloop
+    std::size_t grainsize = 16384;
+    // выводить ли сводную статистику по массиву
+    bool print_stats = false;
+    // шаблон заполнения массива (позиция первого совпадения, плотность совпадений)
+    WorkloadSpec<long long> workload;
+    // режим сервера: "stdin" или путь к Unix domain socket; пустая строка - обычный запуск
+    std::string serve;
+    std::size_t max_batch = 4096;
 
-    // Обработка аргументов командной строки
-    if (argc > 2) {
+    // Обработка аргументов командной строки: опции вида --name значение и позиционные аргументы
+    std::vector<std::string> positional;
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "-h" || arg == "--help") {
+            print_usage(argv[0]);
+            return 0;
+        }
+        if (arg == "--input") {
+            if (i + 1 >= argc) {
+                std::cerr << "Ошибка: после --input нужно указать путь к файлу" << std::endl;
+                print_usage(argv[0]);
+                return 1;
+            }
+            input_path = argv[++i];
+        } else if (arg == "--seed") {
+            if (i + 1 >= argc) {
+                std::cerr << "Ошибка: после --seed нужно указать число" << std::endl;
+                print_usage(argv[0]);
+                return 1;
+            }
+            seed = std::strtoull(argv[++i], nullptr, 10);
+        } else if (arg == "--stats") {
+            print_stats = true;
+        } else if (arg == "--grainsize") {
+            if (i + 1 >= argc) {
+                std::cerr << "Ошибка: после --grainsize нужно указать число" << std::endl;
+                print_usage(argv[0]);
+                return 1;
+            }
+            grainsize = std::strtoull(argv[++i], nullptr, 10);
+        } else if (arg == "--serve" || arg == "--max-batch") {
+            if (i + 1 >= argc) {
+                std::cerr << "Ошибка: после " << arg << " нужно указать значение" << std::endl;
+                print_usage(argv[0]);
+                return 1;
+            }
+            if (arg == "--serve") {
+                serve = argv[++i];
+            } else {
+                max_batch = std::strtoull(argv[++i], nullptr, 10);
+            }
+        } else if (arg == "--pattern" || arg == "--match-pos" || arg == "--density") {
+            if (i + 1 >= argc) {
+                std::cerr << "Ошибка: после " << arg << " нужно указать значение" << std::endl;
+                print_usage(argv[0]);
+                return 1;
+            }
+            std::string value = argv[++i];
+            if (arg == "--pattern") {
+                auto pattern = parse_workload_pattern(value);
+                if (!pattern.has_value()) {
+                    std::cerr << "Ошибка: неизвестный шаблон " << value << std::endl;
+                    print_usage(argv[0]);
+                    return 1;
+                }
+                workload.pattern = pattern.value();
+            } else if (arg == "--match-pos") {
+                workload.match_position = (value == "none") ? std::nullopt : std::optional<double>(std::atof(value.c_str()));
+            } else {
+                workload.density = std::atof(value.c_str());
+            }
+        } else {
+            positional.push_back(arg);
+        }
+    }
+    if (positional.size() > 2) {
         std::cerr << "Ошибка: слишком много аргументов" << std::endl;
         print_usage(argv[0]);
         return 1;
     }
-    if (argc == 2) {
-        if (std::string(argv[1]) == "-h" || std::string(argv[1]) == "--help") {
-            print_usage(argv[0]);
-            return 0;
-        }
-        num_threads = std::atoi(argv[1]);
+    if (positional.size() >= 1) {
+        num_threads = std::atoi(positional[0].c_str());
         if (num_threads.value() < 0) {
             std::cerr << "Ошибка: число потоков не может быть отрицательным" << std::endl;
             print_usage(argv[0]);
             return 1;
         }
     }
+    if (positional.size() == 2) {
+        implementation = positional[1];
+        if (implementation != "reduction" && implementation != "early" &&
+            implementation != "taskloop" && implementation != "adaptive" && implementation != "simd") {
+            std::cerr << "Ошибка: неизвестная реализация " << implementation << std::endl;
+            print_usage(argv[0]);
+            return 1;
+        }
+    }
+
+    if (!serve.empty()) {
+        // В режиме stdin stdout занят ответами, поэтому все сообщения программы уходят в stderr
+        std::cout.rdbuf(std::cerr.rdbuf());
+    }
 
     print_description();
     
     std::unique_ptr<BaseSolver<long long>> solver;
     if (num_threads.has_value() && num_threads.value() == 0) {
         solver = std::make_unique<SequentialSolver<long long>>();
+    } else if (implementation == "simd") {
+        solver = std::make_unique<SimdSolver>();
+    } else if (implementation == "early") {
+        solver = std::make_unique<EarlyExitSolver<long long>>(num_threads);
+    } else if (implementation == "taskloop") {
+        solver = std::make_unique<TaskloopSolver<long long>>(num_threads, grainsize);
+    } else if (implementation == "adaptive") {
+        solver = std::make_unique<AdaptiveSolver<long long>>(num_threads);
     } else {
         solver = std::make_unique<ParallelSolver<long long>>(num_threads);
     }
@@ -70,18 +217,75 @@ int main(int argc, char* argv[]) {
     // Параметры задачи
     constexpr size_t array_size = 10000000;
     constexpr long long threshold = 5000000;
+
+    // Данные: либо отображённый в память файл, либо сгенерированный массив
+    // Решатели в обоих случаях получают std::span без копирования
+    std::unique_ptr<MappedFile> mapped_file;
+    std::unique_ptr<long long[]> generated;
+    std::span<const long long> arr;
+
     std::cout << "========================================" << std::endl;
-    std::cout << "Размер массива:     " << array_size << std::endl;
-    std::cout << "Пороговое значение: " << threshold << std::endl;
-    std::cout << "Массив будет заполнен случайными числами" << std::endl;
-    // Создаём массив случайных чисел
-    std::vector<long long> arr(array_size);
-    std::random_device rd;
-    std::mt19937 gen(rd());
-    std::uniform_int_distribution<long long> distr(std::numeric_limits<long long>::min(), std::numeric_limits<long long>::max());
-    std::generate(arr.begin(), arr.end(), [&]() { return distr(gen); });
+    if (!input_path.empty()) {
+        mapped_file = MappedFile::open(input_path, sizeof(long long));
+        if (!mapped_file) {
+            return 1;
+        }
+        arr = mapped_file->as_span<long long>();
+        std::cout << "Входной файл:       " << input_path << std::endl;
+        std::cout << "Размер массива:     " << arr.size() << std::endl;
+        std::cout << "Пороговое значение: " << threshold << std::endl;
+    } else {
+        std::cout << "Размер массива:     " << array_size << std::endl;
+        std::cout << "Пороговое значение: " << threshold << std::endl;
+        if (!seed.has_value()) {
+            std::random_device rd;
+            seed = (static_cast<std::uint64_t>(rd()) << 32) | rd();
+        }
+        std::cout << "Массив будет заполнен случайными числами (seed = " << seed.value() << ")" << std::endl;
+        if (workload.pattern != WorkloadPattern::Random) {
+            std::size_t first_match = planted_index(workload, array_size);
+            std::cout << "Первое совпадение:  ";
+            if (first_match == array_size) {
+                std::cout << "нет" << std::endl;
+            } else {
+                std::cout << "индекс " << first_match << std::endl;
+            }
+        }
+        // Создаём массив случайных чисел: параллельно, на счётчиковом генераторе,
+        // каждый поток первым касается своей части массива
+        workload.threshold = threshold;
+        workload.seed = seed.value();
+        std::optional<int> fill_threads = (num_threads.has_value() && num_threads.value() > 0) ? num_threads : std::nullopt;
+        generated = make_workload_array<long long>(array_size, workload, fill_threads);
+        arr = std::span<const long long>(generated.get(), array_size);
+    }
     std::cout << "========================================" << std::endl;
         
+    if (!serve.empty()) {
+        QueryServer<long long> server(arr, *solver, max_batch);
+        g_server = &server;
+        // Без SA_RESTART: сигнал прерывает блокирующий read, и сервер видит просьбу остановиться
+        struct sigaction action {};
+        action.sa_handler = handle_stop_signal;
+        sigemptyset(&action.sa_mask);
+        sigaction(SIGINT, &action, nullptr);
+        sigaction(SIGTERM, &action, nullptr);
+
+        bool ok = true;
+        if (serve == "stdin") {
+            std::cout << "Сервер читает пороги из stdin" << std::endl;
+            server.serve_stream(STDIN_FILENO, STDOUT_FILENO);
+        } else {
+            std::cout << "Сервер слушает " << serve << std::endl;
+            ok = server.serve_unix_socket(serve);
+        }
+        g_server = nullptr;
+
+        std::cout << "Обработано порогов: " << server.queries_served()
+                  << ", вызовов solve_many: " << server.batches_served() << std::endl;
+        return ok ? 0 : 1;
+    }
+
     auto result = solver->solve(arr, threshold);
     if (result.has_value()) {
         std::cout << "Найденное значение: " << result.value() << std::endl;
@@ -89,6 +293,23 @@ int main(int argc, char* argv[]) {
         std::cout << "Элемент не найден :(" << std::endl;
     }
     
+    if (print_stats) {
+        SearchStats<long long> stats;
+        if (num_threads.has_value() && num_threads.value() == 0) {
+            stats = compute_stats(arr, threshold);
+        } else {
+            stats = ParallelSolver<long long>(num_threads).solve_stats(arr, threshold);
+        }
+        std::cout << "========================================" << std::endl;
+        std::cout << "Элементов больше порога: " << stats.count_above << std::endl;
+        if (stats.first().has_value()) {
+            std::cout << "Первый из них:           индекс " << stats.first_index << ", значение " << stats.first_value << std::endl;
+        }
+        if (stats.argmax != SearchStats<long long>::kNoIndex) {
+            std::cout << "Максимум:                " << stats.max_value << " (индекс " << stats.argmax << ")" << std::endl;
+        }
+    }
+    
     return 0;
 }
 
@@ -0,0 +1,116 @@
+#pragma once
+
+#include <cassert>
+#include <cerrno>
+#include <cstddef>
+#include <cstring>
+
+#include <iostream>
+#include <memory>
+#include <span>
+#include <string>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/**
+ * Бинарный файл, отображённый в память только для чтения (mmap)
+ *
+ * Данные не копируются: решатели работают прямо по страницам файла через std::span,
+ * поэтому время запуска не зависит от размера набора данных.
+ * Ядру сообщается, что файл будет читаться последовательно (MADV_SEQUENTIAL - агрессивное упреждающее чтение)
+ * и что желательно использовать большие страницы (MADV_HUGEPAGE, где поддерживается)
+ */
+class MappedFile {
+public:
+    /**
+     * Отобразить файл в память
+     * Возвращает nullptr, если файл не удалось открыть или отобразить, или его размер не кратен размеру элемента
+     * (обрезанный файл или файл другого типа; причина печатается в std::cerr)
+     *
+     * @param filename путь к файлу
+     * @param element_size размер одного элемента в байтах (sizeof типа, с которым потом вызывается as_span)
+     * @return указатель на отображение или nullptr
+     */
+    static std::unique_ptr<MappedFile> open(const std::string& filename, std::size_t element_size = 1) {
+        int fd = ::open(filename.c_str(), O_RDONLY);
+        if (fd < 0) {
+            std::cerr << "Ошибка: не удалось открыть файл " << filename << ": " << std::strerror(errno) << std::endl;
+            return nullptr;
+        }
+
+        struct stat st {};
+        if (fstat(fd, &st) != 0) {
+            std::cerr << "Ошибка: не удалось получить размер файла " << filename << ": " << std::strerror(errno) << std::endl;
+            ::close(fd);
+            return nullptr;
+        }
+
+        if (element_size == 0 || static_cast<std::size_t>(st.st_size) % element_size != 0) {
+            std::cerr << "Ошибка: размер файла " << filename << " (" << st.st_size << " байт) не кратен размеру элемента ("
+                      << element_size << " байт) - файл обрезан или содержит данные другого типа" << std::endl;
+            ::close(fd);
+            return nullptr;
+        }
+
+        std::unique_ptr<MappedFile> file(new MappedFile());
+        file->size_ = static_cast<std::size_t>(st.st_size);
+
+        // mmap нулевой длины недопустим - пустой файл просто даёт пустой span
+        if (file->size_ > 0) {
+            void* addr = mmap(nullptr, file->size_, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (addr == MAP_FAILED) {
+                std::cerr << "Ошибка: не удалось отобразить файл " << filename << " в память: " << std::strerror(errno) << std::endl;
+                ::close(fd);
+                return nullptr;
+            }
+            file->data_ = addr;
+
+            // Подсказки ядру; их неудача не ошибка - просто работаем без них
+            madvise(addr, file->size_, MADV_SEQUENTIAL);
+#ifdef MADV_HUGEPAGE
+            madvise(addr, file->size_, MADV_HUGEPAGE);
+#endif
+        }
+
+        // Отображение остаётся валидным и после закрытия дескриптора
+        ::close(fd);
+        return file;
+    }
+
+    ~MappedFile() {
+        if (data_ != nullptr) {
+            munmap(data_, size_);
+        }
+    }
+
+    // Владеет отображением - копирование запрещено
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    /**
+     * Содержимое файла как массив элементов типа T
+     * Размер файла должен быть кратен sizeof(T) - это проверяет open с element_size = sizeof(T)
+     */
+    template<typename T>
+    std::span<const T> as_span() const {
+        assert(size_ % sizeof(T) == 0);
+        return std::span<const T>(static_cast<const T*>(data_), size_ / sizeof(T));
+    }
+
+    /**
+     * Размер файла в байтах
+     */
+    std::size_t size_bytes() const {
+        return size_;
+    }
+
+private:
+    MappedFile() = default;
+
+private:
+    void* data_ = nullptr;
+    std::size_t size_ = 0;
+};
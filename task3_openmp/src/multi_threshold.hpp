@@ -0,0 +1,101 @@
+#pragma once
+
+#include "simd_search.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <limits>
+#include <numeric>
+#include <optional>
+#include <span>
+#include <vector>
+
+/**
+ * Вспомогательные функции для solve_many: поиск первого элемента, большего каждого из нескольких порогов,
+ * за один проход по массиву
+ *
+ * Ключевое наблюдение: если пороги отсортированы по возрастанию, то элемент x удовлетворяет
+ * всем порогам меньше x сразу. Значит, множество уже удовлетворённых порогов - всегда префикс
+ * отсортированного списка, и на каждом шаге достаточно искать элемент, больший наименьшего
+ * ещё открытого порога (обычным ядром find_first_greater), а затем "погасить" все пороги меньше найденного
+ */
+
+// Индекс, означающий "для этого порога элемент не найден"
+inline constexpr std::size_t kNoMatch = std::numeric_limits<std::size_t>::max();
+
+/**
+ * Пороги, отсортированные по возрастанию, вместе с их исходными позициями
+ */
+template<typename T>
+struct SortedThresholds {
+    std::vector<T> values;
+    // order[k] - позиция values[k] во входном массиве порогов
+    std::vector<std::size_t> order;
+};
+
+template<typename T>
+SortedThresholds<T> sort_thresholds(std::span<const T> thresholds) {
+    SortedThresholds<T> sorted;
+    sorted.order.resize(thresholds.size());
+    std::iota(sorted.order.begin(), sorted.order.end(), std::size_t{0});
+    std::stable_sort(sorted.order.begin(), sorted.order.end(), [&](std::size_t a, std::size_t b) {
+        return thresholds[a] < thresholds[b];
+    });
+    sorted.values.reserve(thresholds.size());
+    for (std::size_t pos : sorted.order) {
+        sorted.values.push_back(thresholds[pos]);
+    }
+    return sorted;
+}
+
+/**
+ * Один проход по data[begin, end) с погашением порогов
+ *
+ * @param sorted_values пороги по возрастанию
+ * @return для каждого порога (в отсортированном порядке) индекс первого элемента диапазона, большего порога,
+ *         или kNoMatch; найденные индексы образуют префикс
+ */
+template<typename T>
+std::vector<std::size_t> scan_many(const T* data, std::size_t begin, std::size_t end, const std::vector<T>& sorted_values) {
+    std::vector<std::size_t> result(sorted_values.size(), kNoMatch);
+    std::size_t open = 0; // первый ещё не удовлетворённый порог
+    std::size_t pos = begin;
+    while (open < sorted_values.size() && pos < end) {
+        std::size_t offset = find_first_greater(data + pos, end - pos, sorted_values[open]);
+        if (offset == end - pos) {
+            break;
+        }
+        std::size_t index = pos + offset;
+        // Гасим все пороги, которые меньше найденного элемента
+        while (open < sorted_values.size() && sorted_values[open] < data[index]) {
+            result[open] = index;
+            open++;
+        }
+        pos = index + 1;
+    }
+    return result;
+}
+
+/**
+ * Собрать ответ по результатам scan_many для последовательных частей массива
+ *
+ * @param chunk_results результаты частей в порядке возрастания индексов
+ * @return для каждого порога (в исходном порядке) первый элемент, больший порога, или std::nullopt
+ */
+template<typename T>
+std::vector<std::optional<T>> merge_many(
+    const T* data,
+    const SortedThresholds<T>& sorted,
+    const std::vector<std::vector<std::size_t>>& chunk_results
+) {
+    std::vector<std::optional<T>> answers(sorted.values.size(), std::nullopt);
+    // Пороги, удовлетворённые левыми частями, - префикс; каждая следующая часть может только продлить его
+    std::size_t open = 0;
+    for (const auto& chunk : chunk_results) {
+        while (open < chunk.size() && chunk[open] != kNoMatch) {
+            answers[sorted.order[open]] = data[chunk[open]];
+            open++;
+        }
+    }
+    return answers;
+}
@@ -0,0 +1,153 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <optional>
+#include <span>
+#include <string>
+#include <vector>
+
+#include <omp.h>
+
+/**
+ * Ближайший больший справа (all nearest larger values): для каждой позиции i - наименьший j > i
+ * с arr[j] > arr[i], или arr.size(), если такого нет
+ */
+
+/**
+ * Последовательный алгоритм со стеком за O(n): стек хранит позиции, для которых ответ ещё не найден;
+ * их значения не возрастают от дна к вершине. Очередной элемент снимает со стека все меньшие себя
+ */
+template<typename T>
+void next_greater_serial(std::span<const T> arr, std::span<std::size_t> out) {
+    std::vector<std::size_t> stack;
+    for (std::size_t j = 0; j < arr.size(); j++) {
+        while (!stack.empty() && arr[stack.back()] < arr[j]) {
+            out[stack.back()] = j;
+            stack.pop_back();
+        }
+        stack.push_back(j);
+    }
+    for (std::size_t i : stack) {
+        out[i] = arr.size();
+    }
+}
+
+/**
+ * Параллельный поиск ближайшего большего справа (OpenMP)
+ *
+ * Суть (как и в task1, но обе фазы - в одной параллельной области):
+ *   - первый omp for: каждая часть массива проходится последовательным алгоритмом со своим стеком,
+ *     заодно запоминаются записи префиксного максимума части (позиции, где максимум от начала части строго растёт)
+ *   - неявный барьер в конце omp for - максимумы и записи всех частей готовы
+ *   - второй omp for: позиции, оставшиеся на стеке части, обходятся от вершины ко дну (по неубыванию значения);
+ *     ответ - первая часть правее с максимумом больше значения и бинарный поиск по её записям.
+ *     Номер части и позиция в записях только растут - два указателя
+ */
+template<typename T>
+class NextGreaterSolver {
+public:
+    /**
+     * Конструктор
+     * @param num_threads количество потоков (опционально, если не указано - используется дефолтное значение OpenMP)
+     */
+    explicit NextGreaterSolver(std::optional<int> num_threads = std::nullopt) {
+        if (num_threads.has_value()) {
+            omp_set_num_threads(num_threads.value());
+        }
+    }
+
+    /**
+     * Записать в out[i] ближайший больший справа для каждого i (out.size() == arr.size())
+     */
+    void solve(std::span<const T> arr, std::span<std::size_t> out) const {
+        std::size_t num_chunks = std::min<std::size_t>(omp_get_max_threads(), arr.size());
+        if (num_chunks <= 1) {
+            next_greater_serial(arr, out);
+            return;
+        }
+
+        std::vector<std::vector<std::size_t>> stacks(num_chunks);
+        std::vector<std::vector<std::size_t>> records(num_chunks);
+        std::vector<T> chunk_max(num_chunks);
+
+        #pragma omp parallel
+        {
+            // Фаза 1: локальные стеки и записи префиксного максимума
+            #pragma omp for schedule(static, 1)
+            for (std::size_t c = 0; c < num_chunks; c++) {
+                std::size_t begin = arr.size() * c / num_chunks;
+                std::size_t end = arr.size() * (c + 1) / num_chunks;
+                std::vector<std::size_t>& stack = stacks[c];
+                std::vector<std::size_t>& chunk_records = records[c];
+                for (std::size_t j = begin; j < end; j++) {
+                    T value = arr[j];
+                    while (!stack.empty() && arr[stack.back()] < value) {
+                        out[stack.back()] = j;
+                        stack.pop_back();
+                    }
+                    stack.push_back(j);
+                    if (chunk_records.empty() || arr[chunk_records.back()] < value) {
+                        chunk_records.push_back(j);
+                    }
+                }
+                chunk_max[c] = arr[chunk_records.back()];
+            }
+
+            // Фаза 2: оставшиеся на стеках позиции ищут ответ в частях правее
+            #pragma omp for schedule(static, 1)
+            for (std::size_t c = 0; c < num_chunks; c++) {
+                resolve_chunk(arr, out, c, stacks[c], records, chunk_max);
+            }
+        }
+    }
+
+    /**
+     * То же, с выделением результата
+     */
+    std::vector<std::size_t> solve(std::span<const T> arr) const {
+        std::vector<std::size_t> out(arr.size());
+        solve(arr, out);
+        return out;
+    }
+
+    std::string get_name() const {
+        return "Параллельный ближайший больший справа (OpenMP)";
+    }
+
+private:
+    /**
+     * Ответы для позиций, оставшихся на стеке части c
+     */
+    static void resolve_chunk(std::span<const T> arr, std::span<std::size_t> out, std::size_t c,
+                              const std::vector<std::size_t>& stack,
+                              const std::vector<std::vector<std::size_t>>& records,
+                              const std::vector<T>& chunk_max) {
+        std::size_t num_chunks = chunk_max.size();
+        std::size_t d = c + 1;
+        std::size_t record_pos = 0;
+        for (auto it = stack.rbegin(); it != stack.rend(); ++it) {
+            T value = arr[*it];
+            std::size_t next_d = d;
+            while (next_d < num_chunks && chunk_max[next_d] <= value) {
+                next_d++;
+            }
+            if (next_d == num_chunks) {
+                // Правее нет ничего больше - и для всех позиций глубже в стеке тоже
+                for (; it != stack.rend(); ++it) {
+                    out[*it] = arr.size();
+                }
+                return;
+            }
+            if (next_d != d) {
+                d = next_d;
+                record_pos = 0;
+            }
+            const std::vector<std::size_t>& chunk_records = records[d];
+            auto found = std::upper_bound(chunk_records.begin() + record_pos, chunk_records.end(), value,
+                                          [&arr](T v, std::size_t index) { return v < arr[index]; });
+            record_pos = static_cast<std::size_t>(found - chunk_records.begin());
+            out[*it] = *found;
+        }
+    }
+};
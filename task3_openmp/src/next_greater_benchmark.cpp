@@ -0,0 +1,84 @@
+#include "next_greater.hpp"
+
+#include <cstdlib>
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <optional>
+#include <random>
+#include <string>
+#include <vector>
+
+/**
+ * Бенчмарк ближайшего большего справа: последовательный алгоритм со стеком против параллельного
+ * (локальные стеки частей + слияние через записи префиксного максимума). Результаты сверяются поэлементно
+ */
+
+void print_usage(const char* prog_name) {
+    std::cout << "Использование: " << prog_name << " [размер_массива] [количество_потоков] [диапазон_значений]" << std::endl;
+}
+
+int main(int argc, char* argv[]) {
+    std::size_t array_size = 10000000;
+    std::optional<int> num_threads = std::nullopt;
+    long long value_range = 1000000000LL;
+
+    if (argc > 4) {
+        std::cerr << "Ошибка: слишком много аргументов" << std::endl;
+        print_usage(argv[0]);
+        return 1;
+    }
+    if (argc >= 2 && (std::string(argv[1]) == "-h" || std::string(argv[1]) == "--help")) {
+        print_usage(argv[0]);
+        return 0;
+    }
+    if (argc >= 2) {
+        array_size = std::strtoull(argv[1], nullptr, 10);
+    }
+    if (argc >= 3) {
+        num_threads = std::atoi(argv[2]);
+    }
+    if (argc >= 4) {
+        value_range = std::strtoll(argv[3], nullptr, 10);
+    }
+    if (array_size == 0 || value_range <= 0) {
+        std::cerr << "Ошибка: размер массива и диапазон значений должны быть положительными" << std::endl;
+        return 1;
+    }
+
+    // Значения в [0, value_range): маленький диапазон даёт много равных элементов
+    std::vector<long long> arr(array_size);
+    std::mt19937_64 gen(42);
+    std::uniform_int_distribution<long long> value_distr(0, value_range - 1);
+    std::generate(arr.begin(), arr.end(), [&]() { return value_distr(gen); });
+
+    using clock = std::chrono::steady_clock;
+    auto millis = [](clock::duration d) {
+        return std::chrono::duration<double, std::milli>(d).count();
+    };
+
+    std::vector<std::size_t> serial_out(array_size);
+    auto start = clock::now();
+    next_greater_serial<long long>(arr, serial_out);
+    double serial_time = millis(clock::now() - start);
+
+    NextGreaterSolver<long long> solver(num_threads);
+    std::vector<std::size_t> parallel_out(array_size);
+    start = clock::now();
+    solver.solve(arr, parallel_out);
+    double parallel_time = millis(clock::now() - start);
+
+    std::cout << "Размер массива:          " << array_size << std::endl;
+    std::cout << "Реализация:              " << solver.get_name() << std::endl;
+    std::cout << "========================================" << std::endl;
+    std::cout << "Последовательно:         " << serial_time << " мс" << std::endl;
+    std::cout << "Параллельно:             " << parallel_time << " мс" << std::endl;
+    std::cout << "Ускорение:               " << serial_time / parallel_time << std::endl;
+
+    if (serial_out != parallel_out) {
+        std::cerr << "Ошибка: результаты последовательной и параллельной версий не совпадают" << std::endl;
+        return 1;
+    }
+    return 0;
+}
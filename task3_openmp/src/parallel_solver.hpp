@@ -1,6 +1,7 @@
 #pragma once
 
 #include "base_solver.hpp"
+#include "search_stats.hpp"
 
 #include <cassert>
 
@@ -30,7 +31,7 @@ public:
         }
     }
     
-    std::optional<T> solve(const std::vector<T>& arr, T threshold) override {
+    std::optional<T> solve(std::span<const T> arr, T threshold) override {
         if (arr.empty()) {
             return std::nullopt;
         }
@@ -57,6 +58,49 @@ public:
         return arr[min_index];
     }
     
+    /**
+     * Несколько порогов за один параллельный проход
+     * Массив делится на части по числу потоков OpenMP, каждая часть гасит пороги независимо (scan_many),
+     * затем результаты частей сливаются слева направо (merge_many)
+     */
+    std::vector<std::optional<T>> solve_many(std::span<const T> arr, std::span<const T> thresholds) override {
+        SortedThresholds<T> sorted = sort_thresholds(thresholds);
+        if (arr.empty() || sorted.values.empty()) {
+            return std::vector<std::optional<T>>(thresholds.size(), std::nullopt);
+        }
+
+        std::size_t num_chunks = std::min<std::size_t>(omp_get_max_threads(), arr.size());
+        std::vector<std::vector<std::size_t>> chunk_results(num_chunks);
+
+        #pragma omp parallel for schedule(static, 1)
+        for (std::size_t c = 0; c < num_chunks; c++) {
+            std::size_t begin = arr.size() * c / num_chunks;
+            std::size_t end = arr.size() * (c + 1) / num_chunks;
+            chunk_results[c] = scan_many(arr.data(), begin, end, sorted.values);
+        }
+
+        return merge_many(arr.data(), sorted, chunk_results);
+    }
+
+    /**
+     * Первый элемент больше порога вместе со сводной статистикой (количество таких элементов, максимум и его индекс)
+     * за один параллельный проход: пользовательская редукция OpenMP (declare reduction) по структуре SearchStats,
+     * комбинатор - merge_stats
+     */
+    SearchStats<T> solve_stats(std::span<const T> arr, T threshold) {
+        #pragma omp declare reduction(search_stats : SearchStats<T> : omp_out = merge_stats(omp_out, omp_in)) \
+            initializer(omp_priv = SearchStats<T>{})
+
+        SearchStats<T> stats;
+
+        #pragma omp parallel for reduction(search_stats:stats)
+        for (std::size_t i = 0; i < arr.size(); i++) {
+            stats.add(i, arr[i], threshold);
+        }
+
+        return stats;
+    }
+
     std::string get_name() const override {
         return "Параллельная версия (OpenMP)";
     }
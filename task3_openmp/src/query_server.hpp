@@ -0,0 +1,418 @@
+#pragma once
+
+#include "base_solver.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <condition_variable>
+#include <deque>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+/**
+ * Сервер запросов: массив загружается (или отображается в память) один раз, решатель остаётся "тёплым",
+ * а пороги приходят построчно из stdin или через Unix domain socket
+ *
+ * Протокол - текстовый, построчный:
+ *   - запрос - строка из одного или нескольких порогов через пробел: "5000000" или "10 20 30"
+ *   - ответ - строка с тем же числом полей: первое число больше каждого порога или none
+ *   - на строку, которую не удалось разобрать, отвечает "error ..."; пустые строки игнорируются
+ * Ответы на запросы одного клиента приходят в порядке запросов
+ *
+ * Суть:
+ *   - на каждого клиента - поток чтения: он разбирает всё, что пришло одним read, и кладёт запросы в общую очередь
+ *   - один поток решения забирает из очереди всё накопившееся (не больше max_batch порогов) и отвечает
+ *     на всю микропорцию одним solve_many - один параллельный проход по массиву вместо прохода на каждый порог
+ *   - клиент может не ждать ответа перед следующим запросом (конвейер): пока решается одна порция,
+ *     следующая уже копится в очереди, и под нагрузкой порции сами собой становятся крупнее
+ *   - при низкой нагрузке порция - один запрос, и он решается сразу, без искусственной задержки
+ *
+ * Решатель не создаётся заново на запрос: все solve_many вызываются из одного и того же потока решения,
+ * поэтому OpenMP переиспользует одну и ту же команду потоков между параллельными областями
+ */
+template<typename T>
+class QueryServer {
+public:
+    /**
+     * Конструктор
+     * @param data массив, по которому ищутся ответы (должен жить дольше сервера)
+     * @param solver решатель (используется только из потока решения)
+     * @param max_batch наибольшее число порогов в одной микропорции
+     */
+    QueryServer(std::span<const T> data, BaseSolver<T>& solver, std::size_t max_batch = 4096)
+        : data_(data), solver_(solver), max_batch_(std::max<std::size_t>(max_batch, 1)) {}
+
+    QueryServer(const QueryServer&) = delete;
+    QueryServer& operator=(const QueryServer&) = delete;
+
+    /**
+     * Обслуживать один поток запросов: читать из in_fd, отвечать в out_fd, пока не кончится ввод
+     * (или не будет вызван request_stop)
+     */
+    void serve_stream(int in_fd, int out_fd) {
+        start_solver();
+        reader_loop(std::make_shared<Connection>(in_fd, out_fd, false));
+        stop_solver();
+    }
+
+    /**
+     * Слушать Unix domain socket по пути path и обслуживать клиентов, пока не будет вызван request_stop
+     * @return false, если сокет не удалось создать (причина печатается в std::cerr)
+     */
+    bool serve_unix_socket(const std::string& path) {
+        sockaddr_un addr {};
+        if (path.size() >= sizeof(addr.sun_path)) {
+            std::cerr << "Ошибка: слишком длинный путь к сокету " << path << std::endl;
+            return false;
+        }
+        addr.sun_family = AF_UNIX;
+        std::memcpy(addr.sun_path, path.c_str(), path.size() + 1);
+
+        int listen_fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+        if (listen_fd < 0) {
+            std::cerr << "Ошибка: не удалось создать сокет: " << std::strerror(errno) << std::endl;
+            return false;
+        }
+        // Сокет, оставшийся от прошлого запуска, мешает bind
+        ::unlink(path.c_str());
+        if (::bind(listen_fd, reinterpret_cast<const sockaddr*>(&addr), sizeof(addr)) != 0 ||
+            ::listen(listen_fd, 64) != 0) {
+            std::cerr << "Ошибка: не удалось слушать сокет " << path << ": " << std::strerror(errno) << std::endl;
+            ::close(listen_fd);
+            return false;
+        }
+
+        start_solver();
+
+        std::vector<Reader> readers;
+        while (!stop_requested_.load(std::memory_order_relaxed)) {
+            // Потоки отключившихся клиентов присоединяем сразу, чтобы они не копились за время работы сервера
+            std::erase_if(readers, [](Reader& reader) {
+                if (!reader.finished->load(std::memory_order_acquire)) {
+                    return false;
+                }
+                reader.thread.join();
+                return true;
+            });
+
+            // Ждём клиента с таймаутом, чтобы регулярно проверять request_stop
+            pollfd pfd {listen_fd, POLLIN, 0};
+            if (::poll(&pfd, 1, 100) <= 0) {
+                continue;
+            }
+            int client_fd = ::accept(listen_fd, nullptr, nullptr);
+            if (client_fd < 0) {
+                continue;
+            }
+            auto connection = std::make_shared<Connection>(client_fd, client_fd, true);
+            auto finished = std::make_shared<std::atomic<bool>>(false);
+            std::weak_ptr<Connection> weak = connection;
+            std::thread thread([this, connection = std::move(connection), finished]() mutable {
+                reader_loop(std::move(connection));
+                finished->store(true, std::memory_order_release);
+            });
+            readers.push_back(Reader{std::move(thread), std::move(weak), std::move(finished)});
+        }
+
+        // Будим потоки чтения, заблокированные в read, и дожидаемся их
+        for (auto& reader : readers) {
+            if (auto connection = reader.connection.lock()) {
+                ::shutdown(connection->in_fd, SHUT_RD);
+            }
+        }
+        for (auto& reader : readers) {
+            reader.thread.join();
+        }
+        stop_solver();
+
+        ::close(listen_fd);
+        ::unlink(path.c_str());
+        return true;
+    }
+
+    /**
+     * Попросить сервер остановиться. Только атомарная запись - можно вызывать из обработчика сигнала
+     */
+    void request_stop() {
+        stop_requested_.store(true, std::memory_order_relaxed);
+    }
+
+    /**
+     * Сколько порогов обработано и сколькими вызовами solve_many
+     */
+    std::uint64_t queries_served() const {
+        return queries_served_.load(std::memory_order_relaxed);
+    }
+
+    std::uint64_t batches_served() const {
+        return batches_served_.load(std::memory_order_relaxed);
+    }
+
+private:
+    /**
+     * Клиент: откуда читаем запросы и куда пишем ответы
+     * Живёт, пока его держит поток чтения или хотя бы один его запрос в очереди
+     */
+    struct Connection {
+        int in_fd;
+        int out_fd;
+        // Сокет клиента закрывается вместе с Connection; stdin/stdout - нет
+        bool is_socket;
+
+        Connection(int in, int out, bool socket) : in_fd(in), out_fd(out), is_socket(socket) {}
+
+        ~Connection() {
+            if (is_socket) {
+                ::close(in_fd);
+            }
+        }
+
+        /**
+         * Записать всё; ошибки записи (клиент отключился) игнорируются
+         */
+        void write_all(const std::string& text) const {
+            std::size_t written = 0;
+            while (written < text.size()) {
+                // Для сокета - send с MSG_NOSIGNAL, чтобы отключившийся клиент не убил процесс SIGPIPE
+                ssize_t n = is_socket ? ::send(out_fd, text.data() + written, text.size() - written, MSG_NOSIGNAL)
+                                      : ::write(out_fd, text.data() + written, text.size() - written);
+                if (n < 0 && errno == EINTR) {
+                    continue;
+                }
+                if (n <= 0) {
+                    return;
+                }
+                written += static_cast<std::size_t>(n);
+            }
+        }
+    };
+
+    /**
+     * Поток чтения одного клиента сокета
+     */
+    struct Reader {
+        std::thread thread;
+        std::weak_ptr<Connection> connection;
+        std::shared_ptr<std::atomic<bool>> finished;
+    };
+
+    /**
+     * Одна строка запроса
+     */
+    struct Request {
+        std::shared_ptr<Connection> connection;
+        std::vector<T> thresholds;
+        // Непустая - строку не удалось разобрать, ответ - эта ошибка
+        std::string error;
+    };
+
+    /**
+     * Разобрать строку запроса: пороги через пробелы
+     */
+    static Request parse_request(std::shared_ptr<Connection> connection, const std::string& line) {
+        Request request;
+        request.connection = std::move(connection);
+        const char* cursor = line.c_str();
+        while (true) {
+            while (*cursor == ' ' || *cursor == '\t' || *cursor == '\r') {
+                cursor++;
+            }
+            if (*cursor == '\0') {
+                break;
+            }
+            char* end = nullptr;
+            errno = 0;
+            long long value = std::strtoll(cursor, &end, 10);
+            if (end == cursor || errno == ERANGE ||
+                (*end != '\0' && *end != ' ' && *end != '\t' && *end != '\r')) {
+                request.thresholds.clear();
+                request.error = "error: expected integer thresholds";
+                break;
+            }
+            request.thresholds.push_back(static_cast<T>(value));
+            cursor = end;
+        }
+        return request;
+    }
+
+    /**
+     * Поток чтения: делит входные байты на строки и кладёт в очередь всё, что пришло одним read
+     */
+    void reader_loop(std::shared_ptr<Connection> connection) {
+        std::string pending;
+        std::vector<char> buffer(1 << 16);
+        while (!stop_requested_.load(std::memory_order_relaxed)) {
+            ssize_t n = ::read(connection->in_fd, buffer.data(), buffer.size());
+            if (n < 0 && errno == EINTR) {
+                continue;
+            }
+            if (n <= 0) {
+                break;
+            }
+            pending.append(buffer.data(), static_cast<std::size_t>(n));
+
+            std::vector<Request> requests;
+            std::size_t line_start = 0;
+            for (std::size_t newline = pending.find('\n'); newline != std::string::npos;
+                 newline = pending.find('\n', line_start)) {
+                std::string line = pending.substr(line_start, newline - line_start);
+                line_start = newline + 1;
+                Request request = parse_request(connection, line);
+                if (!request.thresholds.empty() || !request.error.empty()) {
+                    requests.push_back(std::move(request));
+                }
+            }
+            pending.erase(0, line_start);
+            enqueue(std::move(requests));
+        }
+
+        // Последняя строка без перевода строки - тоже запрос
+        if (!pending.empty()) {
+            std::vector<Request> requests;
+            Request request = parse_request(connection, pending);
+            if (!request.thresholds.empty() || !request.error.empty()) {
+                requests.push_back(std::move(request));
+            }
+            enqueue(std::move(requests));
+        }
+    }
+
+    void enqueue(std::vector<Request>&& requests) {
+        if (requests.empty()) {
+            return;
+        }
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            for (auto& request : requests) {
+                queue_.push_back(std::move(request));
+            }
+        }
+        cv_.notify_one();
+    }
+
+    void start_solver() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            queue_closed_ = false;
+        }
+        solver_thread_ = std::thread(&QueryServer::solver_loop, this);
+    }
+
+    /**
+     * Закрыть очередь: поток решения ответит на всё, что в ней осталось, и завершится
+     */
+    void stop_solver() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            queue_closed_ = true;
+        }
+        cv_.notify_one();
+        solver_thread_.join();
+    }
+
+    /**
+     * Поток решения: микропорция из очереди -> один solve_many -> ответы по клиентам
+     */
+    void solver_loop() {
+        while (true) {
+            std::vector<Request> batch;
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                cv_.wait(lock, [this] { return queue_closed_ || !queue_.empty(); });
+                if (queue_.empty()) {
+                    // queue_closed_ == true и запросов больше нет
+                    return;
+                }
+                // Всё накопившееся, но не больше max_batch_ порогов (и хотя бы одна строка)
+                std::size_t batch_thresholds = 0;
+                while (!queue_.empty() &&
+                       (batch.empty() || batch_thresholds + queue_.front().thresholds.size() <= max_batch_)) {
+                    batch_thresholds += queue_.front().thresholds.size();
+                    batch.push_back(std::move(queue_.front()));
+                    queue_.pop_front();
+                }
+            }
+            answer_batch(batch);
+        }
+    }
+
+    void answer_batch(const std::vector<Request>& batch) {
+        std::vector<T> thresholds;
+        for (const auto& request : batch) {
+            thresholds.insert(thresholds.end(), request.thresholds.begin(), request.thresholds.end());
+        }
+
+        std::vector<std::optional<T>> answers;
+        if (!thresholds.empty()) {
+            answers = solver_.solve_many(data_, thresholds);
+            queries_served_.fetch_add(thresholds.size(), std::memory_order_relaxed);
+            batches_served_.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        // Ответы собираются по клиентам в порядке запросов и отправляются одной записью на клиента
+        std::vector<std::pair<Connection*, std::string>> replies;
+        std::size_t next_answer = 0;
+        for (const auto& request : batch) {
+            std::string* reply = nullptr;
+            for (auto& [connection, text] : replies) {
+                if (connection == request.connection.get()) {
+                    reply = &text;
+                    break;
+                }
+            }
+            if (reply == nullptr) {
+                replies.emplace_back(request.connection.get(), std::string());
+                reply = &replies.back().second;
+            }
+
+            if (!request.error.empty()) {
+                *reply += request.error;
+            } else {
+                for (std::size_t i = 0; i < request.thresholds.size(); i++, next_answer++) {
+                    if (i > 0) {
+                        *reply += ' ';
+                    }
+                    const auto& answer = answers[next_answer];
+                    *reply += answer.has_value() ? std::to_string(answer.value()) : std::string("none");
+                }
+            }
+            *reply += '\n';
+        }
+
+        for (const auto& [connection, text] : replies) {
+            connection->write_all(text);
+        }
+    }
+
+private:
+    std::span<const T> data_;
+    BaseSolver<T>& solver_;
+    std::size_t max_batch_;
+
+    std::deque<Request> queue_;
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    bool queue_closed_ = false;
+    std::thread solver_thread_;
+
+    std::atomic<bool> stop_requested_{false};
+    std::atomic<std::uint64_t> queries_served_{0};
+    std::atomic<std::uint64_t> batches_served_{0};
+};
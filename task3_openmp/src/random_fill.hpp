@@ -0,0 +1,87 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <span>
+
+#include <omp.h>
+
+
+/**
+ * Параллельная генерация случайного массива на счётчиковом генераторе (SplitMix64) с OpenMP
+ *
+ * Суть:
+ *   - значение элемента i зависит только от seed и i: value(i) = mix(key + (i + 1) * gamma),
+ *     где key = mix(seed + gamma) - первый выход SplitMix64, засеянного seed. Значит, value(i) - ровно i-й выход
+ *     (с нуля) последовательного SplitMix64, засеянного key
+ *   - поэтому любой диапазон индексов можно заполнить независимо от остальных,
+ *     и результат детерминирован для заданного seed и не зависит от числа потоков
+ *   - память выделяется без инициализации, и каждый поток первым пишет в свою часть
+ *     (first touch): страницы оказываются на том узле NUMA, где работает поток,
+ *     который при статическом разбиении будет эту часть и просматривать
+ */
+
+namespace random_fill_detail {
+
+inline constexpr std::uint64_t kGamma = 0x9e3779b97f4a7c15ULL;
+
+inline std::uint64_t mix(std::uint64_t z) {
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+    return z ^ (z >> 31);
+}
+
+} // namespace random_fill_detail
+
+/**
+ * Случайное 64-битное значение для позиции index при заданном seed
+ */
+inline std::uint64_t counter_random(std::uint64_t seed, std::uint64_t index) {
+    using namespace random_fill_detail;
+    std::uint64_t key = mix(seed + kGamma);
+    return mix(key + (index + 1) * kGamma);
+}
+
+/**
+ * Заполнить массив параллельно значениями out[i] = value_at(i): каждый поток OpenMP пишет свою непрерывную часть
+ * (schedule(static) - то же разбиение, что у parallel for в ParallelSolver)
+ * value_at должна зависеть только от i - тогда результат не зависит от числа потоков
+ *
+ * @param out массив для заполнения
+ * @param value_at функция индекс -> значение
+ * @param num_threads количество потоков (опционально, если не указано - используется дефолтное значение OpenMP)
+ */
+template<typename T, typename ValueAt>
+void fill_parallel(std::span<T> out, ValueAt value_at, std::optional<int> num_threads = std::nullopt) {
+    int threads_count = num_threads.has_value() ? std::max(num_threads.value(), 1) : omp_get_max_threads();
+
+    #pragma omp parallel for schedule(static) num_threads(threads_count)
+    for (std::size_t i = 0; i < out.size(); i++) {
+        out[i] = value_at(i);
+    }
+}
+
+/**
+ * Заполнить весь массив случайными значениями параллельно
+ *
+ * @param out массив для заполнения
+ * @param seed зерно генератора
+ * @param num_threads количество потоков (опционально, если не указано - используется дефолтное значение OpenMP)
+ */
+template<typename T>
+void fill_random(std::span<T> out, std::uint64_t seed, std::optional<int> num_threads = std::nullopt) {
+    fill_parallel(out, [seed](std::size_t i) { return static_cast<T>(counter_random(seed, i)); }, num_threads);
+}
+
+/**
+ * Выделить массив из size элементов без инициализации и заполнить его параллельно (с first touch)
+ * В отличие от std::vector<T>(size), память не обнуляется одним потоком заранее
+ */
+template<typename T>
+std::unique_ptr<T[]> make_random_array(std::size_t size, std::uint64_t seed, std::optional<int> num_threads = std::nullopt) {
+    std::unique_ptr<T[]> data = std::make_unique_for_overwrite<T[]>(size);
+    fill_random(std::span<T>(data.get(), size), seed, num_threads);
+    return data;
+}
@@ -0,0 +1,90 @@
+#pragma once
+
+#include <cstddef>
+#include <limits>
+#include <optional>
+#include <span>
+
+/**
+ * Сводка по массиву относительно порога, собираемая за один проход:
+ *   - первый элемент, превышающий порог (индекс и значение)
+ *   - количество элементов, превышающих порог
+ *   - максимальный элемент и индекс его первого вхождения
+ *
+ * Раньше для этого требовалось 3-4 отдельных прохода по массиву; здесь все величины
+ * накапливаются вместе, и массив читается из памяти один раз.
+ * Две сводки по соседним частям массива объединяются merge_stats - это и есть комбинатор
+ * пользовательской редукции OpenMP (declare reduction в ParallelSolver::solve_stats)
+ */
+template<typename T>
+struct SearchStats {
+    // Индекс, означающий "такого элемента нет"
+    static constexpr std::size_t kNoIndex = std::numeric_limits<std::size_t>::max();
+
+    std::size_t first_index = kNoIndex;
+    T first_value = T{};
+    std::size_t count_above = 0;
+    T max_value = std::numeric_limits<T>::lowest();
+    std::size_t argmax = kNoIndex;
+
+    /**
+     * Первый элемент, превышающий порог (то же, что возвращает solve)
+     */
+    std::optional<T> first() const {
+        if (first_index == kNoIndex) {
+            return std::nullopt;
+        }
+        return first_value;
+    }
+
+    /**
+     * Учесть элемент arr[index] = value
+     * Порядок обхода не важен: при равенстве побеждает меньший индекс
+     */
+    void add(std::size_t index, T value, T threshold) {
+        if (value > threshold) {
+            count_above++;
+            if (index < first_index) {
+                first_index = index;
+                first_value = value;
+            }
+        }
+        if (argmax == kNoIndex || value > max_value || (value == max_value && index < argmax)) {
+            max_value = value;
+            argmax = index;
+        }
+    }
+};
+
+/**
+ * Объединить сводки по двум непересекающимся частям массива
+ * Операция ассоциативна и коммутативна, поэтому годится как комбинатор редукции OpenMP
+ */
+template<typename T>
+SearchStats<T> merge_stats(const SearchStats<T>& a, const SearchStats<T>& b) {
+    SearchStats<T> result = a;
+    result.count_above += b.count_above;
+    if (b.first_index < result.first_index) {
+        result.first_index = b.first_index;
+        result.first_value = b.first_value;
+    }
+    if (b.argmax != SearchStats<T>::kNoIndex &&
+        (result.argmax == SearchStats<T>::kNoIndex || b.max_value > result.max_value ||
+         (b.max_value == result.max_value && b.argmax < result.argmax))) {
+        result.max_value = b.max_value;
+        result.argmax = b.argmax;
+    }
+    return result;
+}
+
+/**
+ * Сводка по массиву за один последовательный проход
+ */
+template<typename T>
+SearchStats<T> compute_stats(std::span<const T> arr, T threshold) {
+    SearchStats<T> stats;
+    for (std::size_t i = 0; i < arr.size(); i++) {
+        stats.add(i, arr[i], threshold);
+    }
+    return stats;
+}
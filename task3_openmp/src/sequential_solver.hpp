@@ -11,7 +11,7 @@
 template<typename T>
 class SequentialSolver : public BaseSolver<T> {
 public:
-    std::optional<T> solve(const std::vector<T>& arr, T threshold) override {
+    std::optional<T> solve(std::span<const T> arr, T threshold) override {
         if (arr.empty()) {
             return std::nullopt;
         }
@@ -0,0 +1,166 @@
+#pragma once
+
+#include "cpu_features.hpp"
+
+#include <cstddef>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define SIMD_SEARCH_X86 1
+#endif
+
+/**
+ * Ядро поиска: индекс первого элемента data[0..n), большего threshold
+ *
+ * Общая (скалярная) версия - для любого типа T
+ * Для long long ниже есть перегрузка с векторными сравнениями
+ *
+ * @return индекс найденного элемента или n, если такого элемента нет
+ */
+template<typename T>
+inline std::size_t find_first_greater(const T* data, std::size_t n, T threshold) {
+    for (std::size_t i = 0; i < n; i++) {
+        if (data[i] > threshold) {
+            return i;
+        }
+    }
+    return n;
+}
+
+/**
+ * Варианты векторного ядра для 64-битных целых
+ *
+ * Каждый вариант собирается под свой набор инструкций через __attribute__((target)),
+ * поэтому бинарник компилируется без -mavx2 и запускается на любом x86-64,
+ * а нужный вариант выбирается во время выполнения по CPUID (см. find_first_greater ниже)
+ *
+ * Суть векторных вариантов:
+ *   - за одну инструкцию сравниваются 2 (SSE4.2, _mm_cmpgt_epi64), 4 (AVX2, _mm256_cmpgt_epi64)
+ *     или 8 (AVX-512, _mm512_cmpgt_epi64_mask) элементов
+ *   - цикл развёрнут на 128 байт (две кэш-линии): маски сравнений объединяются,
+ *     и только если что-то нашлось, ищем точную позицию через movemask + tzcnt (__builtin_ctz)
+ *   - хвост, не кратный ширине развёртки, добивается скалярным циклом
+ */
+namespace simd_search_detail {
+
+inline std::size_t scalar_tail(const long long* data, std::size_t i, std::size_t n, long long threshold) {
+    for (; i < n; i++) {
+        if (data[i] > threshold) {
+            return i;
+        }
+    }
+    return n;
+}
+
+inline std::size_t find_first_greater_scalar(const long long* data, std::size_t n, long long threshold) {
+    return scalar_tail(data, 0, n, threshold);
+}
+
+#if defined(SIMD_SEARCH_X86)
+
+__attribute__((target("sse4.2")))
+inline std::size_t find_first_greater_sse42(const long long* data, std::size_t n, long long threshold) {
+    const __m128i thr = _mm_set1_epi64x(threshold);
+    std::size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m128i c0 = _mm_cmpgt_epi64(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i)), thr);
+        __m128i c1 = _mm_cmpgt_epi64(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i + 2)), thr);
+        __m128i c2 = _mm_cmpgt_epi64(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i + 4)), thr);
+        __m128i c3 = _mm_cmpgt_epi64(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i + 6)), thr);
+        __m128i any = _mm_or_si128(_mm_or_si128(c0, c1), _mm_or_si128(c2, c3));
+        if (!_mm_testz_si128(any, any)) {
+            // По 2 бита маски (старшие биты 64-битных сравнений) на каждый вектор
+            unsigned mask = static_cast<unsigned>(_mm_movemask_pd(_mm_castsi128_pd(c0)))
+                          | static_cast<unsigned>(_mm_movemask_pd(_mm_castsi128_pd(c1))) << 2
+                          | static_cast<unsigned>(_mm_movemask_pd(_mm_castsi128_pd(c2))) << 4
+                          | static_cast<unsigned>(_mm_movemask_pd(_mm_castsi128_pd(c3))) << 6;
+            return i + __builtin_ctz(mask);
+        }
+    }
+    return scalar_tail(data, i, n, threshold);
+}
+
+__attribute__((target("avx2")))
+inline std::size_t find_first_greater_avx2(const long long* data, std::size_t n, long long threshold) {
+    const __m256i thr = _mm256_set1_epi64x(threshold);
+    std::size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        __m256i c0 = _mm256_cmpgt_epi64(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i)), thr);
+        __m256i c1 = _mm256_cmpgt_epi64(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i + 4)), thr);
+        __m256i c2 = _mm256_cmpgt_epi64(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i + 8)), thr);
+        __m256i c3 = _mm256_cmpgt_epi64(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i + 12)), thr);
+        __m256i any = _mm256_or_si256(_mm256_or_si256(c0, c1), _mm256_or_si256(c2, c3));
+        if (!_mm256_testz_si256(any, any)) {
+            // По 4 бита маски (старшие биты 64-битных сравнений) на каждый вектор
+            unsigned mask = static_cast<unsigned>(_mm256_movemask_pd(_mm256_castsi256_pd(c0)))
+                          | static_cast<unsigned>(_mm256_movemask_pd(_mm256_castsi256_pd(c1))) << 4
+                          | static_cast<unsigned>(_mm256_movemask_pd(_mm256_castsi256_pd(c2))) << 8
+                          | static_cast<unsigned>(_mm256_movemask_pd(_mm256_castsi256_pd(c3))) << 12;
+            return i + __builtin_ctz(mask);
+        }
+    }
+    return scalar_tail(data, i, n, threshold);
+}
+
+__attribute__((target("avx512f")))
+inline std::size_t find_first_greater_avx512(const long long* data, std::size_t n, long long threshold) {
+    const __m512i thr = _mm512_set1_epi64(threshold);
+    std::size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        __mmask8 m0 = _mm512_cmpgt_epi64_mask(_mm512_loadu_si512(data + i), thr);
+        __mmask8 m1 = _mm512_cmpgt_epi64_mask(_mm512_loadu_si512(data + i + 8), thr);
+        unsigned mask = static_cast<unsigned>(m0) | (static_cast<unsigned>(m1) << 8);
+        if (mask != 0) {
+            return i + __builtin_ctz(mask);
+        }
+    }
+    return scalar_tail(data, i, n, threshold);
+}
+
+#endif // SIMD_SEARCH_X86
+
+using FindFirstGreaterFn = std::size_t (*)(const long long*, std::size_t, long long);
+
+struct Kernel {
+    FindFirstGreaterFn fn;
+    const char* name;
+};
+
+/**
+ * Выбрать лучший доступный вариант ядра (один раз, по CPUID)
+ */
+inline const Kernel& selected_kernel() {
+    static const Kernel kernel = [] {
+#if defined(SIMD_SEARCH_X86)
+        const CpuFeatures& cpu = cpu_features();
+        if (cpu.avx512f) {
+            return Kernel{find_first_greater_avx512, "AVX-512"};
+        }
+        if (cpu.avx2) {
+            return Kernel{find_first_greater_avx2, "AVX2"};
+        }
+        if (cpu.sse42) {
+            return Kernel{find_first_greater_sse42, "SSE4.2"};
+        }
+#endif
+        return Kernel{find_first_greater_scalar, "scalar"};
+    }();
+    return kernel;
+}
+
+} // namespace simd_search_detail
+
+/**
+ * Имя набора инструкций, выбранного для векторного ядра на этом процессоре
+ */
+inline const char* simd_kernel_name() {
+    return simd_search_detail::selected_kernel().name;
+}
+
+/**
+ * Векторная версия ядра для 64-битных целых
+ * Вызывает вариант, выбранный по CPUID при первом обращении (scalar, SSE4.2, AVX2 или AVX-512)
+ */
+inline std::size_t find_first_greater(const long long* data, std::size_t n, long long threshold) {
+    return simd_search_detail::selected_kernel().fn(data, n, threshold);
+}
@@ -0,0 +1,27 @@
+#pragma once
+
+#include "base_solver.hpp"
+#include "simd_search.hpp"
+
+#include <string>
+
+/**
+ * Последовательная реализация задачи на векторных инструкциях
+ * Проходит массив слева направо ядром find_first_greater из simd_search.hpp:
+ * сравнивает 4 (AVX2) или 8 (AVX-512) элементов за инструкцию,
+ * так что поиск упирается в пропускную способность памяти, а не в сравнения
+ */
+class SimdSolver : public BaseSolver<long long> {
+public:
+    std::optional<long long> solve(std::span<const long long> arr, long long threshold) override {
+        std::size_t index = find_first_greater(arr.data(), arr.size(), threshold);
+        if (index == arr.size()) {
+            return std::nullopt;
+        }
+        return arr[index];
+    }
+
+    std::string get_name() const override {
+        return std::string("Последовательная SIMD-версия (") + simd_kernel_name() + ")";
+    }
+};
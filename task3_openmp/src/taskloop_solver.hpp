@@ -0,0 +1,138 @@
+#pragma once
+
+#include "base_solver.hpp"
+#include "simd_search.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <limits>
+#include <string>
+#include <vector>
+
+#include <omp.h>
+
+/**
+ * Параллельная реализация задачи на задачах OpenMP (taskloop)
+ *
+ * В parallel for итерации делятся между потоками заранее (или раздаются по одной - schedule(dynamic)),
+ * а здесь один поток порождает задачи, которые забирают свободные потоки команды.
+ * Если поток вытеснен соседним процессом, его задачи просто выполнят другие - нагрузка балансируется сама
+ *
+ * Суть:
+ *   - массив делится на блоки по kBlockSize элементов; taskloop порождает задачи по grainsize элементов
+ *     (grainsize / kBlockSize блоков) в порядке возрастания индекса
+ *   - порядок выполнения задач выбирает среда OpenMP (libgomp, например, часто берёт последние порождённые),
+ *     поэтому итерация задачи не привязана к своему блоку, а берёт следующий блок из общего курсора next_block:
+ *     блоки просматриваются слева направо, какая бы задача ни выполнялась
+ *   - найденный индекс публикуется в общий атомарный best_index циклом CAS-min
+ *   - задача, дошедшая до выполнения после того, как найден элемент левее её блоков, отбрасывается без чтения
+ *   - при OMP_CANCELLATION=true нашедшая задача выполняет cancel taskgroup, и ещё не начатые задачи
+ *     не запускаются вовсе; непросмотренные блоки левее ответа досматриваются после taskloop,
+ *     так что результат - по-прежнему минимальный индекс
+ */
+template<typename T>
+class TaskloopSolver : public BaseSolver<T> {
+public:
+    // Сколько элементов просматривается между проверками best_index
+    static constexpr std::size_t kBlockSize = 1024;
+
+    /**
+     * Конструктор
+     * @param num_threads количество потоков (опционально, если не указано - используется дефолтное значение OpenMP)
+     * @param grainsize примерное число элементов на одну задачу (округляется до кратного kBlockSize)
+     */
+    explicit TaskloopSolver(std::optional<int> num_threads = std::nullopt, std::size_t grainsize = 16384)
+        : num_threads_(num_threads), grain_blocks_(std::max<std::size_t>(grainsize / kBlockSize, 1)) {}
+
+private:
+    // Значение best_index, означающее "ничего не найдено"
+    static constexpr std::size_t kNotFound = std::numeric_limits<std::size_t>::max();
+
+public:
+    std::optional<T> solve(std::span<const T> arr, T threshold) override {
+        if (arr.empty()) {
+            return std::nullopt;
+        }
+
+        const T* data = arr.data();
+        std::size_t n = arr.size();
+        std::size_t num_blocks = (n + kBlockSize - 1) / kBlockSize;
+        std::size_t grain_blocks = grain_blocks_;
+        int threads = num_threads_.has_value() ? std::max(num_threads_.value(), 1) : omp_get_max_threads();
+
+        std::atomic<std::size_t> best_index{kNotFound};
+        std::atomic<std::size_t> next_block{0};
+        // scanned[b] != 0 - блок b просмотрен целиком (нужно только при отмене задач)
+        std::vector<unsigned char> scanned(num_blocks, 0);
+
+        #pragma omp parallel num_threads(threads)
+        #pragma omp single
+        {
+            // Задачи порождаются в порядке возрастания индекса; неявная taskgroup дожидается их всех
+            #pragma omp taskloop grainsize(grain_blocks)
+            for (std::size_t i = 0; i < num_blocks; i++) {
+                #pragma omp cancellation point taskgroup
+
+                // Итераций ровно столько, сколько блоков, поэтому каждый блок достанется ровно одной итерации
+                std::size_t b = next_block.fetch_add(1, std::memory_order_relaxed);
+                std::size_t begin = b * kBlockSize;
+                // Уже найден элемент левее - этот блок не нужен
+                if (begin > best_index.load(std::memory_order_relaxed)) {
+                    continue;
+                }
+
+                std::size_t len = std::min(kBlockSize, n - begin);
+                std::size_t offset = find_first_greater(data + begin, len, threshold);
+                scanned[b] = 1;
+                if (offset != len) {
+                    publish_min_index(best_index, begin + offset);
+                    #pragma omp cancel taskgroup
+                }
+            }
+        }
+
+        // После отмены досматриваем блоки левее ответа, которые так и не были просмотрены
+        std::size_t min_index = best_index.load(std::memory_order_relaxed);
+        for (std::size_t b = 0; min_index != kNotFound && b <= min_index / kBlockSize; b++) {
+            if (scanned[b]) {
+                continue;
+            }
+            std::size_t begin = b * kBlockSize;
+            std::size_t len = std::min(kBlockSize, n - begin);
+            std::size_t offset = find_first_greater(data + begin, len, threshold);
+            if (offset != len) {
+                min_index = std::min(min_index, begin + offset);
+            }
+        }
+
+        // Элемент, больший порога, не найден
+        if (min_index == kNotFound) {
+            return std::nullopt;
+        }
+
+        return arr[min_index];
+    }
+
+    std::string get_name() const override {
+        std::string name = "Параллельная версия (OpenMP taskloop, grainsize " + std::to_string(grain_blocks_ * kBlockSize);
+        if (omp_get_cancellation()) {
+            name += ", omp cancel";
+        }
+        return name + ")";
+    }
+
+private:
+    /**
+     * Опубликовать найденный индекс: best_index = min(best_index, index) циклом CAS
+     */
+    static void publish_min_index(std::atomic<std::size_t>& best_index, std::size_t index) {
+        std::size_t current = best_index.load(std::memory_order_relaxed);
+        while (index < current &&
+               !best_index.compare_exchange_weak(current, index, std::memory_order_relaxed)) {
+        }
+    }
+
+private:
+    std::optional<int> num_threads_;
+    std::size_t grain_blocks_;
+};
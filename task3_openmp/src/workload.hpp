@@ -0,0 +1,189 @@
+#pragma once
+
+#include "random_fill.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <optional>
+#include <span>
+#include <string>
+
+
+/**
+ * Генератор входных данных с управляемой нагрузкой
+ *
+ * Случайный массив по всему диапазону long long почти всегда содержит подходящий элемент
+ * на позиции 0 или 1, и бенчмарк решателей измеряет только запуск потоков.
+ * Здесь позиция первого совпадения и плотность последующих задаются явно
+ *
+ * Шаблоны (WorkloadPattern):
+ *   - random      - равномерно по всему диапазону T (как раньше; позиция и плотность игнорируются)
+ *   - planted     - фон: случайные значения <= threshold; первое совпадение - ровно на match_position,
+ *                   после него каждый элемент - совпадение с вероятностью density
+ *   - sorted      - возрастающая последовательность: arr[i] > threshold тогда и только тогда, когда i >= позиции
+ *   - reverse     - убывающий фон <= threshold, совпадения - как в planted
+ *   - adversarial - фон ровно равен threshold (граница строгого сравнения: ни один блок нельзя отбросить
+ *                   по максимуму, ни один элемент не подходит), совпадения - как в planted
+ *
+ * Значение каждого элемента - функция только от (параметров, n, i), поэтому массив заполняется
+ * параллельно (fill_parallel) и детерминирован для заданного seed при любом числе потоков
+ */
+enum class WorkloadPattern {
+    Random,
+    Planted,
+    Sorted,
+    Reverse,
+    Adversarial,
+};
+
+/**
+ * Разобрать имя шаблона; std::nullopt, если имя неизвестно
+ */
+inline std::optional<WorkloadPattern> parse_workload_pattern(const std::string& name) {
+    if (name == "random") {
+        return WorkloadPattern::Random;
+    }
+    if (name == "planted") {
+        return WorkloadPattern::Planted;
+    }
+    if (name == "sorted") {
+        return WorkloadPattern::Sorted;
+    }
+    if (name == "reverse") {
+        return WorkloadPattern::Reverse;
+    }
+    if (name == "adversarial") {
+        return WorkloadPattern::Adversarial;
+    }
+    return std::nullopt;
+}
+
+template<typename T>
+struct WorkloadSpec {
+    WorkloadPattern pattern = WorkloadPattern::Random;
+    // Порог, относительно которого планируются совпадения
+    T threshold = 0;
+    // Позиция первого совпадения как доля n из [0, 1]; std::nullopt - совпадений нет вообще
+    std::optional<double> match_position = 0.5;
+    // Доля совпадений среди элементов после первого (0 - единственное совпадение)
+    double density = 0.0;
+    std::uint64_t seed = 0;
+};
+
+/**
+ * Индекс первого совпадения для массива из n элементов, или n, если совпадений нет
+ */
+template<typename T>
+std::size_t planted_index(const WorkloadSpec<T>& spec, std::size_t n) {
+    if (!spec.match_position.has_value() || n == 0) {
+        return n;
+    }
+    double fraction = std::clamp(spec.match_position.value(), 0.0, 1.0);
+    return std::min(static_cast<std::size_t>(fraction * static_cast<double>(n)), n - 1);
+}
+
+namespace workload_detail {
+
+// Случайное значение из [lo, hi] по 64 случайным битам
+template<typename T>
+T value_in_range(std::uint64_t bits, T lo, T hi) {
+    std::uint64_t span = static_cast<std::uint64_t>(hi) - static_cast<std::uint64_t>(lo) + 1;
+    if (span == 0) {
+        // [lo, hi] - весь диапазон 64-битного типа
+        return static_cast<T>(bits);
+    }
+    return static_cast<T>(static_cast<std::uint64_t>(lo) + bits % span);
+}
+
+// Значение строго больше threshold (если threshold - максимум T, больше быть не может - возвращаем максимум)
+template<typename T>
+T above(std::uint64_t bits, T threshold) {
+    if (threshold == std::numeric_limits<T>::max()) {
+        return threshold;
+    }
+    return value_in_range<T>(bits, threshold + 1, std::numeric_limits<T>::max());
+}
+
+// Случайное значение не больше threshold
+template<typename T>
+T below(std::uint64_t bits, T threshold) {
+    return value_in_range<T>(bits, std::numeric_limits<T>::lowest(), threshold);
+}
+
+// base + delta с насыщением до границ T: знаковое переполнение - UB, а при пороге у края диапазона
+// значения по обе стороны от first должны остаться по свою сторону порога
+template<typename T>
+T add_saturated(T base, long long delta) {
+    if (delta > 0 && base > std::numeric_limits<T>::max() - delta) {
+        return std::numeric_limits<T>::max();
+    }
+    if (delta < 0 && base < std::numeric_limits<T>::lowest() - delta) {
+        return std::numeric_limits<T>::lowest();
+    }
+    return static_cast<T>(base + delta);
+}
+
+// Совпадение ли элемент i после первого при заданной плотности
+inline bool is_extra_match(std::uint64_t bits, double density) {
+    // Старшие 53 бита -> равномерное число из [0, 1)
+    double u = static_cast<double>(bits >> 11) * (1.0 / 9007199254740992.0);
+    return u < density;
+}
+
+} // namespace workload_detail
+
+/**
+ * Значение элемента i массива из n элементов
+ */
+template<typename T>
+T workload_value(const WorkloadSpec<T>& spec, std::size_t n, std::size_t i) {
+    using namespace workload_detail;
+    std::uint64_t bits = counter_random(spec.seed, i);
+    std::size_t first = planted_index(spec, n);
+    T t = spec.threshold;
+
+    switch (spec.pattern) {
+    case WorkloadPattern::Random:
+        return static_cast<T>(bits);
+    case WorkloadPattern::Sorted:
+        // Линейно возрастающая последовательность, которая пересекает порог ровно на позиции first
+        return add_saturated<T>(t, 1 + (static_cast<long long>(i) - static_cast<long long>(first)));
+    default:
+        break;
+    }
+
+    // planted, reverse, adversarial: совпадение на first и с вероятностью density после него
+    if (i == first || (i > first && is_extra_match(counter_random(spec.seed ^ 0x5bd1e995ULL, i), spec.density))) {
+        return above<T>(bits, t);
+    }
+    switch (spec.pattern) {
+    case WorkloadPattern::Reverse:
+        // Убывает от threshold
+        return add_saturated<T>(t, -static_cast<long long>(i));
+    case WorkloadPattern::Adversarial:
+        return t;
+    default:
+        return below<T>(bits, t);
+    }
+}
+
+/**
+ * Заполнить массив по шаблону параллельно (каждый поток первым пишет свою часть)
+ */
+template<typename T>
+void fill_workload(std::span<T> out, const WorkloadSpec<T>& spec, std::optional<int> num_threads = std::nullopt) {
+    std::size_t n = out.size();
+    fill_parallel(out, [&spec, n](std::size_t i) { return workload_value(spec, n, i); }, num_threads);
+}
+
+/**
+ * Выделить массив без инициализации и заполнить его по шаблону
+ */
+template<typename T>
+std::unique_ptr<T[]> make_workload_array(std::size_t size, const WorkloadSpec<T>& spec, std::optional<int> num_threads = std::nullopt) {
+    std::unique_ptr<T[]> data = std::make_unique_for_overwrite<T[]>(size);
+    fill_workload(std::span<T>(data.get(), size), spec, num_threads);
+    return data;
+}